@@ -0,0 +1,279 @@
+#include "GeneticKernel.hpp"
+#include "AntColonyOptimization.hpp"
+#include "DoubleRomanDomination.hpp"
+#include "Random.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Microbenchmarks of the hot kernels.
+ *
+ * Measures the genetic operators (repair on both graph backends, both crossovers, both selections
+ * and a whole generation of the default kernel on each backend), AntColonyOptimization::
+ * constructSolution, reduceSolution and both chooseVertex overloads, LocalSearch::improve from a
+ * chromosome of the first population, and Graph::deleteAdjacencyList on seeded G(n, p) graphs of several orders
+ * and average degrees. Every kernel is sampled `repetitions` times; a sample times a batch of
+ * operations (setup excluded) and yields ns/op. The median, mean, standard deviation and minimum
+ * of the samples are reported, and optionally written as CSV.
+ *
+ * Usage: bench_kernels [--sizes 100,1000] [--degrees 4,16] [--repetitions N] [--filter NAME] [--csv FILE]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+struct Statistics {
+    double median;
+    double mean;
+    double deviation;
+    double minimum;
+};
+
+struct Settings {
+    std::vector<size_t> sizes = { 100, 1000 };
+    std::vector<size_t> degrees = { 4, 16 };
+    size_t repetitions = 15;
+    size_t populationSize = 100;
+    std::string filter;
+    std::string csvFile;
+};
+
+class KernelBenchmark {
+    private:
+        Graph graph;
+        CompactGraph compactGraph;
+        std::vector<Chromosome> population;
+        AntColonyOptimization ACO;
+        std::vector<int> solution;
+        std::vector<int> twoOrZeroLabeledVertices;
+        size_t repetitions;
+
+        Statistics sample(size_t operations, const std::function<void()>& setup,
+                          const std::function<void()>& operation);
+
+    public:
+        KernelBenchmark(Graph& graph, size_t populationSize, size_t repetitions);
+
+        std::vector<std::pair<std::string, Statistics>> run(const std::string& filter);
+};
+
+KernelBenchmark::KernelBenchmark(Graph& graph, size_t populationSize, size_t repetitions)
+    : graph(graph), compactGraph(graph), ACO(graph, 1, 1), repetitions(repetitions) {
+    GeneticKernelFactory::create(GeneticOperators(), graph)->createPopulation(this->population, populationSize);
+    this->ACO.initializePheromones(this->ACO.graphPheromone);
+    this->solution = DoubleRomanDomination::heuristic3(graph).genes;
+
+    for (size_t i = 0; i < this->solution.size(); ++i)
+        if (this->solution[i] == 0 || this->solution[i] == 2)
+            this->twoOrZeroLabeledVertices.push_back(i);
+}
+
+/**
+ * @brief Times `repetitions` batches of `operations` calls of `operation`; `setup` runs untimed
+ * before each call.
+ */
+
+Statistics KernelBenchmark::sample(size_t operations, const std::function<void()>& setup,
+                                   const std::function<void()>& operation) {
+    std::vector<double> samples;
+
+    setup();
+    operation();
+
+    for (size_t r = 0; r < this->repetitions; ++r) {
+        double elapsed = 0.0;
+
+        for (size_t i = 0; i < operations; ++i) {
+            setup();
+            auto start = Clock::now();
+            operation();
+            elapsed += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        }
+
+        samples.push_back(elapsed / operations);
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    Statistics statistics = { samples[samples.size() / 2], 0.0, 0.0, samples.front() };
+    for (const auto& it: samples)
+        statistics.mean += it / samples.size();
+    for (const auto& it: samples)
+        statistics.deviation += (it - statistics.mean) * (it - statistics.mean) / samples.size();
+    statistics.deviation = std::sqrt(statistics.deviation);
+
+    return statistics;
+}
+
+std::vector<std::pair<std::string, Statistics>> KernelBenchmark::run(const std::string& filter) {
+    std::vector<std::pair<std::string, Statistics>> results;
+    size_t order = this->graph.getOrder();
+    size_t operations = std::max<size_t>(1, 20000 / order);
+
+    auto measure = [&](const std::string& name, size_t count, const std::function<void()>& setup,
+                       const std::function<void()>& operation) {
+        if (filter.empty() || name.find(filter) != std::string::npos)
+            results.push_back({ name, sample(count, setup, operation) });
+    };
+    auto nothing = []() {};
+
+    std::mt19937& engine = Random::engine();
+    std::vector<int> genes1 = this->population[0].genes;
+    std::vector<int> genes2 = this->population[1].genes;
+    std::vector<int> candidate;
+
+    measure("DominationRepair<Graph>::apply", operations * 10,
+        [&]() { candidate = genes1; },
+        [&]() { DominationRepair<Graph>::apply(this->graph, candidate); });
+
+    measure("DominationRepair<CompactGraph>::apply", operations * 10,
+        [&]() { candidate = genes1; },
+        [&]() { DominationRepair<CompactGraph>::apply(this->compactGraph, candidate); });
+
+    measure("TwoPointCrossover::apply", operations * 10, nothing,
+        [&]() { TwoPointCrossover::apply(genes1, genes2, engine); });
+
+    measure("UniformCrossover::apply", operations * 10, nothing,
+        [&]() { UniformCrossover::apply(genes1, genes2, engine); });
+
+    std::vector<size_t> pool;
+    auto fillPool = [&]() {
+        pool.resize(this->population.size());
+        std::iota(pool.begin(), pool.end(), size_t(0));
+    };
+
+    measure("TournamentSelection::selectParents", 50, fillPool,
+        [&]() { TournamentSelection::selectParents(this->population, pool, engine); });
+
+    measure("RouletteWheelSelection::selectParents", 50, fillPool,
+        [&]() { RouletteWheelSelection::selectParents(this->population, pool, engine); });
+
+    for (const std::string backend: { "compact", "lists" }) {
+        GeneticOperators operators;
+        operators.backend = backend;
+        std::unique_ptr<GenerationKernel> kernel = GeneticKernelFactory::create(operators, this->graph);
+        std::vector<Chromosome> generation = this->population;
+
+        measure("GenerationKernel::nextGeneration(" + backend + ")", std::max<size_t>(1, operations / 10), nothing,
+            [&]() { kernel->nextGeneration(generation, generation.size()); });
+    }
+
+    std::vector<int> unlabeled(order, -1);
+    measure("AntColonyOptimization::constructSolution", operations, nothing,
+        [&]() { this->ACO.constructSolution(unlabeled); });
+
+    measure("AntColonyOptimization::reduceSolution", std::max<size_t>(1, operations / 10), nothing,
+        [&]() { this->ACO.reduceSolution(this->solution); });
+
+    LocalSearch localSearch(this->graph);
+    measure("LocalSearch::improve", std::max<size_t>(1, operations / 10),
+        [&]() { candidate = genes1; },
+        [&]() { localSearch.improve(candidate); });
+
+    Graph temp = this->graph;
+    measure("AntColonyOptimization::chooseVertex(Graph&)", operations * 10, nothing,
+        [&]() { this->ACO.chooseVertex(temp); });
+
+    measure("AntColonyOptimization::chooseVertex(std::vector<int>)", operations * 10, nothing,
+        [&]() { this->ACO.chooseVertex(this->twoOrZeroLabeledVertices); });
+
+    std::uniform_int_distribution<size_t> gap(0, order - 1);
+    Graph residual = this->graph;
+    size_t vertex = 0;
+    measure("Graph::deleteAdjacencyList", operations * 10,
+        [&]() {
+            if (residual.getOrder() == 0)
+                residual = this->graph;
+            do {
+                vertex = gap(Random::engine());
+            } while (!residual.vertexExists(vertex));
+        },
+        [&]() { residual.deleteAdjacencyList(vertex); });
+
+    return results;
+}
+
+static std::vector<size_t> parseList(const std::string& list) {
+    std::vector<size_t> values;
+    std::stringstream stream(list);
+    std::string item;
+
+    while (std::getline(stream, item, ','))
+        values.push_back(std::stoul(item));
+    return values;
+}
+
+static Settings parseSettings(int argc, char** argv) {
+    Settings settings;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc)
+                throw std::invalid_argument("Missing value for " + argument);
+            return argv[++i];
+        };
+
+        if (argument == "--sizes") settings.sizes = parseList(value());
+        else if (argument == "--degrees") settings.degrees = parseList(value());
+        else if (argument == "--repetitions") settings.repetitions = std::stoul(value());
+        else if (argument == "--population") settings.populationSize = std::stoul(value());
+        else if (argument == "--filter") settings.filter = value();
+        else if (argument == "--csv") settings.csvFile = value();
+        else throw std::invalid_argument("Unknown option " + argument);
+    }
+
+    return settings;
+}
+
+int main(int argc, char** argv) {
+    Settings settings;
+
+    try {
+        settings = parseSettings(argc, argv);
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+
+    std::ofstream csv;
+    if (!settings.csvFile.empty()) {
+        csv.open(settings.csvFile);
+        csv << "kernel,order,average_degree,median_ns,mean_ns,stddev_ns,min_ns\n";
+    }
+
+    std::cout << std::left << std::setw(54) << "kernel" << std::right << std::setw(8) << "n" << std::setw(6) << "deg"
+              << std::setw(14) << "median(ns)" << std::setw(14) << "mean(ns)" << std::setw(12) << "stddev"
+              << std::setw(14) << "min(ns)" << std::endl;
+
+    for (const auto& order: settings.sizes) {
+        for (const auto& degree: settings.degrees) {
+            Random::seed(static_cast<unsigned int>(order * 31 + degree));
+            Graph graph(order, false, std::min(1.0f, static_cast<float>(degree) / order));
+            KernelBenchmark benchmark(graph, settings.populationSize, settings.repetitions);
+
+            for (const auto& result: benchmark.run(settings.filter)) {
+                const Statistics& statistics = result.second;
+
+                std::cout << std::left << std::setw(54) << result.first << std::right << std::setw(8) << order
+                          << std::setw(6) << degree << std::fixed << std::setprecision(0)
+                          << std::setw(14) << statistics.median << std::setw(14) << statistics.mean
+                          << std::setw(12) << statistics.deviation << std::setw(14) << statistics.minimum << std::endl;
+
+                if (csv.is_open())
+                    csv << result.first << ',' << order << ',' << degree << ',' << statistics.median << ','
+                        << statistics.mean << ',' << statistics.deviation << ',' << statistics.minimum << '\n';
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,307 @@
+#include "AntColonyOptimization.hpp"
+#include "DominationState.hpp"
+#include "VertexOrdering.hpp"
+#include "Random.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <linux/perf_event.h>
+#include <sstream>
+#include <string>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * @brief Measures how the vertex orderings of VertexOrdering change the cache behavior of the
+ * vertex-indexed kernels.
+ *
+ * Instances are random geometric graphs, which have a natural locality, with their ids shuffled so
+ * the file order hides it, plus any graph file given with --graph. For every ordering the graph is
+ * relabeled and three kernels are timed: a feasibility check (DominationState built from a
+ * labeling and every vertex tested, as `feasible` does), a gather of a per-vertex float over each
+ * neighborhood (the access pattern of the pheromone lookups) and, on instances of at most 5000
+ * vertices, one ACO iteration with one ant. The same labeling, mapped to the new ids, is
+ * used by every ordering.
+ *
+ * Cache misses and L1 data-cache read misses are counted with perf_event_open(2) for the calling
+ * thread; where perf events are not available (containers, perf_event_paranoid > 2) they are
+ * reported as -1 and only times are measured.
+ *
+ * Usage: bench_ordering [--sizes 2000,20000,200000] [--degree 8] [--graph FILE]... [--repetitions N] [--csv FILE]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps the results of the kernels alive so the compiler cannot drop them.
+static volatile double sink;
+
+struct Settings {
+    std::vector<size_t> sizes = { 2000, 20000, 200000 };
+    double degree = 8.0;
+    std::vector<std::string> graphs;
+    size_t repetitions = 5;
+    std::string csvFile;
+};
+
+struct Measurement {
+    double milliseconds;
+    long long cacheMisses;
+    long long l1ReadMisses;
+};
+
+class PerfCounter {
+    private:
+        int descriptor;
+
+    public:
+        PerfCounter(uint32_t type, uint64_t config) {
+            perf_event_attr attributes;
+            std::memset(&attributes, 0, sizeof(attributes));
+            attributes.type = type;
+            attributes.size = sizeof(attributes);
+            attributes.config = config;
+            attributes.disabled = 1;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            descriptor = static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+        }
+
+        ~PerfCounter() {
+            if (descriptor >= 0)
+                close(descriptor);
+        }
+
+        PerfCounter(const PerfCounter&) = delete;
+        PerfCounter& operator=(const PerfCounter&) = delete;
+
+        void start() {
+            if (descriptor >= 0) {
+                ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+                ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+
+        long long stop() {
+            if (descriptor < 0)
+                return -1;
+
+            long long value = 0;
+            ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+            return read(descriptor, &value, sizeof(value)) == sizeof(value) ? value : -1;
+        }
+};
+
+/**
+ * @brief Runs `kernel` `repetitions` times and keeps the run with the median time.
+ */
+
+static Measurement measure(size_t repetitions, const std::function<void()>& kernel) {
+    PerfCounter cacheMisses(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    PerfCounter l1ReadMisses(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    std::vector<Measurement> measurements;
+
+    for (size_t i = 0; i < repetitions; ++i) {
+        cacheMisses.start();
+        l1ReadMisses.start();
+        auto start = Clock::now();
+
+        kernel();
+
+        double elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        long long misses = cacheMisses.stop();
+        measurements.push_back({ elapsed, misses, l1ReadMisses.stop() });
+    }
+
+    std::sort(measurements.begin(), measurements.end(), [](const Measurement& a, const Measurement& b) {
+        return a.milliseconds < b.milliseconds;
+    });
+
+    return measurements[measurements.size() / 2];
+}
+
+/**
+ * @brief Random geometric graph on the unit square with the given average degree, ids shuffled.
+ */
+
+static Graph geometricGraph(size_t order, double degree, unsigned int seed) {
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<double> coordinate(0.0, 1.0);
+    std::vector<std::pair<double, double>> points(order);
+    std::vector<size_t> ids(order);
+
+    for (size_t i = 0; i < order; ++i) {
+        points[i] = { coordinate(engine), coordinate(engine) };
+        ids[i] = i;
+    }
+
+    std::shuffle(ids.begin(), ids.end(), engine);
+
+    double radius = std::sqrt(degree / (M_PI * order));
+    size_t cells = std::max<size_t>(1, static_cast<size_t>(1.0 / radius));
+    std::vector<std::vector<size_t>> grid(cells * cells);
+
+    auto cellOf = [cells](double value) { return std::min(cells - 1, static_cast<size_t>(value * cells)); };
+
+    for (size_t i = 0; i < order; ++i)
+        grid[cellOf(points[i].first) * cells + cellOf(points[i].second)].push_back(i);
+
+    Graph graph(order, false);
+
+    for (size_t i = 0; i < order; ++i) {
+        size_t x = cellOf(points[i].first), y = cellOf(points[i].second);
+
+        for (size_t dx = x > 0 ? x - 1 : 0; dx <= std::min(cells - 1, x + 1); ++dx)
+            for (size_t dy = y > 0 ? y - 1 : 0; dy <= std::min(cells - 1, y + 1); ++dy)
+                for (const auto& j: grid[dx * cells + dy]) {
+                    double distanceX = points[i].first - points[j].first;
+                    double distanceY = points[i].second - points[j].second;
+                    if ((j > i) && (distanceX * distanceX + distanceY * distanceY <= radius * radius))
+                        graph.addEdge(ids[i], ids[j]);
+                }
+    }
+
+    return graph;
+}
+
+static std::vector<size_t> parseList(const std::string& text) {
+    std::vector<size_t> values;
+    std::stringstream stream(text);
+    std::string item;
+
+    while (std::getline(stream, item, ','))
+        values.push_back(std::stoul(item));
+
+    return values;
+}
+
+static Settings parseSettings(int argc, char** argv) {
+    Settings settings;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc)
+                throw std::invalid_argument("Missing value for " + argument);
+            return argv[++i];
+        };
+
+        if (argument == "--sizes") settings.sizes = parseList(value());
+        else if (argument == "--degree") settings.degree = std::stod(value());
+        else if (argument == "--graph") settings.graphs.push_back(value());
+        else if (argument == "--repetitions") settings.repetitions = std::stoul(value());
+        else if (argument == "--csv") settings.csvFile = value();
+        else throw std::invalid_argument("Unknown option " + argument);
+    }
+
+    return settings;
+}
+
+int main(int argc, char** argv) {
+    Settings settings;
+
+    try {
+        settings = parseSettings(argc, argv);
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<std::pair<std::string, std::function<Graph()>>> instances;
+    for (const auto& order: settings.sizes)
+        instances.push_back({ "rgg-" + std::to_string(order),
+                              [order, &settings]() { return geometricGraph(order, settings.degree, 7); } });
+    for (const auto& file: settings.graphs)
+        instances.push_back({ file, [file]() { return Graph(file, false); } });
+
+    const std::vector<std::pair<std::string, OrderingStrategy>> orderings = {
+        { "none", OrderingStrategy::Identity }, { "bfs", OrderingStrategy::BFS },
+        { "rcm", OrderingStrategy::ReverseCuthillMcKee }, { "degree", OrderingStrategy::DegreeDescending },
+        { "community", OrderingStrategy::Community } };
+
+    std::ofstream csv;
+    if (!settings.csvFile.empty()) {
+        csv.open(settings.csvFile);
+        csv << "instance,ordering,kernel,order,neighbor_distance,reorder_ms,median_ms,cache_misses,l1d_read_misses\n";
+    }
+
+    std::cout << std::left << std::setw(16) << "instance" << std::setw(11) << "ordering" << std::setw(14) << "kernel"
+              << std::right << std::setw(12) << "distance" << std::setw(12) << "reorder(ms)" << std::setw(12)
+              << "median(ms)" << std::setw(16) << "cache-misses" << std::setw(16) << "L1D-misses" << std::endl;
+
+    for (const auto& instance: instances) {
+        Graph original = instance.second();
+        size_t order = original.getOrder();
+
+        std::mt19937 engine(11);
+        std::discrete_distribution<int> labelDistribution({ 60, 10, 20, 10 });
+        std::vector<int> labels(order);
+        std::vector<float> pheromones(order);
+        for (size_t i = 0; i < order; ++i) {
+            labels[i] = labelDistribution(engine);
+            pheromones[i] = std::uniform_real_distribution<float>(0.0f, 1.0f)(engine);
+        }
+
+        for (const auto& ordering: orderings) {
+            auto start = Clock::now();
+            VertexOrdering vertexOrdering(original, ordering.second);
+            Graph graph = vertexOrdering.apply(original);
+            double reorderMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+            std::vector<int> reorderedLabels = vertexOrdering.toReordered(labels);
+            std::vector<float> reorderedPheromones(order);
+            for (size_t i = 0; i < order; ++i)
+                reorderedPheromones[vertexOrdering.getNewId(i)] = pheromones[i];
+
+            size_t dominated = 0;
+            double gathered = 0.0;
+
+            std::vector<std::pair<std::string, std::function<void()>>> kernels = {
+                { "feasibility", [&]() {
+                    DominationState state(graph, reorderedLabels);
+                    for (size_t i = 0; i < order; ++i)
+                        dominated += state.isDominated(i) ? 1 : 0;
+                } },
+                { "gather", [&]() {
+                    for (size_t i = 0; i < order; ++i)
+                        for (const auto& neighbor: graph.getAdjacencyList(i))
+                            gathered += reorderedPheromones[neighbor];
+                } } };
+
+            if (order <= 5000)
+                kernels.push_back({ "aco-iteration", [&]() {
+                    Random::seed(5);
+                    AntColonyOptimization ACO(graph, 1, 1);
+                    ACO.run();
+                } });
+
+            double distance = VertexOrdering::averageNeighborDistance(graph);
+
+            for (const auto& kernel: kernels) {
+                Measurement measurement = measure(settings.repetitions, kernel.second);
+
+                std::cout << std::left << std::setw(16) << instance.first << std::setw(11) << ordering.first
+                          << std::setw(14) << kernel.first << std::right << std::fixed << std::setprecision(1)
+                          << std::setw(12) << distance << std::setw(12) << reorderMilliseconds << std::setprecision(3)
+                          << std::setw(12) << measurement.milliseconds << std::setw(16) << measurement.cacheMisses
+                          << std::setw(16) << measurement.l1ReadMisses << std::endl;
+
+                if (csv.is_open())
+                    csv << instance.first << ',' << ordering.first << ',' << kernel.first << ',' << order << ','
+                        << distance << ',' << reorderMilliseconds << ',' << measurement.milliseconds << ','
+                        << measurement.cacheMisses << ',' << measurement.l1ReadMisses << '\n';
+            }
+
+            sink = dominated + gathered;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "PheromoneKernel.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+ * @brief Microbenchmark of the pheromone update.
+ *
+ * Compares the former multi-pass update (PheromoneKernel::updateReference) with the fused kernel
+ * selected at runtime, for n = 10^4 .. 10^7 vertices. Reports the median time per update and per
+ * vertex over a fixed number of repetitions, plus the largest difference between both results.
+ */
+
+template <typename Update>
+static double measure(Update update, PheromoneVector& pheromone, size_t repetitions) {
+    std::vector<double> times;
+
+    for (size_t r = 0; r < repetitions; ++r) {
+        std::fill(pheromone.begin(), pheromone.end(), 0.5f);
+        auto start = std::chrono::steady_clock::now();
+        update();
+        times.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+int main() {
+    constexpr float evaporationRate = 0.2f;
+    constexpr float minBound = 0.001f;
+    constexpr float maxBound = 0.999f;
+    std::mt19937 seed(42);
+    std::uniform_int_distribution<int> label(0, 3);
+
+    std::cout << "implementation: " << PheromoneKernel::getImplementationName() << std::endl;
+    std::cout << std::setw(10) << "n" << std::setw(16) << "reference(ns)" << std::setw(14) << "fused(ns)"
+              << std::setw(18) << "reference(ns/v)" << std::setw(14) << "fused(ns/v)"
+              << std::setw(10) << "speedup" << std::setw(12) << "|cf diff|" << std::endl;
+
+    for (size_t n = 10000; n <= 10000000; n *= 10) {
+        std::vector<int> currentBestSolution(n), bestSolution(n);
+        for (size_t i = 0; i < n; ++i) {
+            currentBestSolution[i] = label(seed);
+            bestSolution[i] = label(seed);
+        }
+
+        PheromoneVector pheromone(n, 0.5f);
+        PheromoneSummary reference{}, fused{};
+        size_t repetitions = n >= 1000000 ? 11 : 101;
+
+        double referenceTime = measure([&]() {
+            reference = PheromoneKernel::updateReference(pheromone.data(), currentBestSolution.data(),
+                    bestSolution.data(), n, 0.5f, 0.5f, evaporationRate, minBound, maxBound);
+        }, pheromone, repetitions);
+
+        double fusedTime = measure([&]() {
+            fused = PheromoneKernel::update(pheromone.data(), currentBestSolution.data(),
+                    bestSolution.data(), n, 0.5f, 0.5f, evaporationRate, minBound, maxBound);
+        }, pheromone, repetitions);
+
+        std::cout << std::setw(10) << n << std::setw(16) << std::fixed << std::setprecision(0) << referenceTime
+                  << std::setw(14) << fusedTime << std::setw(18) << std::setprecision(3) << referenceTime / n
+                  << std::setw(14) << fusedTime / n << std::setw(10) << std::setprecision(2) << referenceTime / fusedTime
+                  << std::setw(12) << std::scientific << std::setprecision(1)
+                  << std::abs(reference.convergenceFactor - fused.convergenceFactor) << std::defaultfloat << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,331 @@
+#include "GeneticAlgorithm.hpp"
+#include "DoubleRomanDomination.hpp"
+#include "AntColonyOptimization.hpp"
+#include "DominationState.hpp"
+#include "TabuSearch.hpp"
+#include "Random.hpp"
+#include <chrono>
+#include <dirent.h>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <vector>
+
+#ifndef DRD_COMMIT
+#define DRD_COMMIT "unknown"
+#endif
+
+/**
+ * @brief End-to-end benchmark of the solvers.
+ *
+ * Runs heuristic1/2/3, the Genetic Algorithm, the ACO and the tabu search over a corpus of
+ * generated G(n, p) instances and of the graph files found in an instance directory, once per
+ * seed. For every run it records the wall time, the time spent loading the instance, solving and
+ * verifying, the RVNS time (ACO), the number of evaluations (iterations for the tabu search) and
+ * evaluations per second, the peak RSS and the gamma2R found, and writes them as CSV and JSON so
+ * runs of different commits can be compared.
+ *
+ * Usage: bench_solvers [--quick] [--seeds N] [--instances DIR] [--csv FILE] [--json FILE]
+ *                      [--population N] [--generations N] [--ants N] [--iterations N]
+ *                      [--tabu-iterations N]
+ */
+
+struct Instance {
+    std::string name;
+    std::string family;
+    std::function<Graph()> load;
+};
+
+struct Record {
+    std::string instance;
+    std::string family;
+    std::string algorithm;
+    unsigned int seed;
+    size_t order;
+    size_t size;
+    double loadMilliseconds;
+    double solveMilliseconds;
+    double verifyMilliseconds;
+    double rvnsMilliseconds;
+    double wallMilliseconds;
+    size_t evaluations;
+    long peakRSSKilobytes;
+    size_t gamma2r;
+    bool feasible;
+};
+
+struct Settings {
+    bool quick = false;
+    size_t seeds = 3;
+    std::string instanceDirectory = "bench/instances";
+    std::string csvFile = "bench_results.csv";
+    std::string jsonFile = "bench_results.json";
+    size_t populationSize = 100;
+    size_t generations = 20;
+    size_t numberOfAnts = 10;
+    size_t iterations = 10;
+    size_t tabuIterations = 10000;
+};
+
+using Clock = std::chrono::steady_clock;
+
+static double milliseconds(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/**
+ * @brief Resets the peak RSS of the process (Linux >= 4.0), so each run reports its own peak.
+ */
+
+static void resetPeakRSS() {
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (clearRefs)
+        clearRefs << "5";
+}
+
+/**
+ * @brief Peak resident set size in kB: VmHWM, or the getrusage maximum if /proc is not available.
+ */
+
+static long readPeakRSS() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0)
+            return std::stol(line.substr(6));
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+static bool isFeasible(const Graph& graph, const std::vector<int>& solution) {
+    if (solution.size() != graph.getOrder())
+        return false;
+
+    DominationState state(graph, solution);
+    for (size_t i = 0; i < solution.size(); ++i)
+        if (solution[i] < 0 || !state.isDominated(i))
+            return false;
+    return true;
+}
+
+static std::vector<Instance> buildCorpus(const Settings& settings) {
+    std::vector<Instance> corpus;
+    std::vector<size_t> orders = settings.quick ? std::vector<size_t>{ 50, 100 } : std::vector<size_t>{ 100, 300, 1000 };
+
+    for (const auto& order: orders) {
+        std::vector<std::pair<std::string, float>> families = {
+            { "sparse", 4.0f / order }, { "medium", 0.05f }, { "dense", 0.2f }
+        };
+
+        for (const auto& family: families) {
+            float probability = family.second;
+            corpus.push_back({ "gnp-" + family.first + "-" + std::to_string(order), family.first,
+                [order, probability]() {
+                    Random::seed(static_cast<unsigned int>(order * 7919));
+                    return Graph(order, false, probability);
+                } });
+        }
+    }
+
+    DIR* directory = opendir(settings.instanceDirectory.c_str());
+    if (directory) {
+        std::vector<std::string> files;
+        for (dirent* entry = readdir(directory); entry; entry = readdir(directory)) {
+            std::string name = entry->d_name;
+            if (name.size() > 4 && name.substr(name.size() - 4) == ".txt")
+                files.push_back(name);
+        }
+        closedir(directory);
+        std::sort(files.begin(), files.end());
+
+        for (const auto& name: files) {
+            std::string path = settings.instanceDirectory + "/" + name;
+            corpus.push_back({ name.substr(0, name.size() - 4), "file", [path]() { return Graph(path, false); } });
+        }
+    }
+
+    return corpus;
+}
+
+static Record runAlgorithm(const Instance& instance, const std::string& algorithm, unsigned int seed,
+                           const Settings& settings) {
+    Record record = {};
+    record.instance = instance.name;
+    record.family = instance.family;
+    record.algorithm = algorithm;
+    record.seed = seed;
+
+    resetPeakRSS();
+    auto start = Clock::now();
+    Graph graph = instance.load();
+    auto loaded = Clock::now();
+
+    record.order = graph.getOrder();
+    record.size = graph.getSize();
+    Random::seed(seed);
+
+    std::vector<int> solution;
+
+    if (algorithm == "heuristic1" || algorithm == "heuristic2" || algorithm == "heuristic3") {
+        Chromosome chromosome = algorithm == "heuristic1" ? DoubleRomanDomination::heuristic1(graph)
+                              : algorithm == "heuristic2" ? DoubleRomanDomination::heuristic2(graph)
+                              : DoubleRomanDomination::heuristic3(graph);
+        solution = chromosome.genes;
+        record.evaluations = 1;
+    }
+
+    else if (algorithm == "ga") {
+        GeneticAlgorithm geneticAlgorithm(graph, settings.populationSize, graph.getOrder(), settings.generations);
+        geneticAlgorithm.run(settings.generations);
+        solution = geneticAlgorithm.getBestSolution();
+        record.evaluations = geneticAlgorithm.getNumberOfEvaluations();
+    }
+
+    else if (algorithm == "tabu") {
+        TabuSettings tabuSettings;
+        tabuSettings.iterations = settings.tabuIterations;
+        TabuSearch tabuSearch(graph, tabuSettings);
+        tabuSearch.run(DoubleRomanDomination::heuristic1(graph).genes);
+        solution = tabuSearch.getBestSolution();
+        record.evaluations = tabuSearch.getStatistics().iterations;
+    }
+
+    else {
+        AntColonyOptimization ACO(graph, settings.iterations, settings.numberOfAnts);
+        ACO.run();
+        solution = ACO.getBestSolution();
+        record.evaluations = ACO.getNumberOfEvaluations();
+        record.rvnsMilliseconds = ACO.getRVNSStatistics().elapsedMicroseconds / 1000.0;
+    }
+
+    auto solved = Clock::now();
+    record.feasible = isFeasible(graph, solution);
+    auto verified = Clock::now();
+
+    record.gamma2r = graph.getWeight(solution);
+
+    record.loadMilliseconds = milliseconds(start, loaded);
+    record.solveMilliseconds = milliseconds(loaded, solved);
+    record.verifyMilliseconds = milliseconds(solved, verified);
+    record.wallMilliseconds = milliseconds(start, verified);
+    record.peakRSSKilobytes = readPeakRSS();
+
+    return record;
+}
+
+static double evaluationsPerSecond(const Record& record) {
+    return record.solveMilliseconds > 0.0 ? record.evaluations / (record.solveMilliseconds / 1000.0) : 0.0;
+}
+
+static void writeCSV(const std::string& filename, const std::vector<Record>& records) {
+    std::ofstream file(filename);
+
+    file << "commit,instance,family,order,size,algorithm,seed,wall_ms,load_ms,solve_ms,verify_ms,rvns_ms,"
+            "evaluations,evaluations_per_second,peak_rss_kb,gamma2r,feasible\n";
+
+    for (const auto& record: records) {
+        file << DRD_COMMIT << ',' << record.instance << ',' << record.family << ',' << record.order << ','
+             << record.size << ',' << record.algorithm << ',' << record.seed << ',' << record.wallMilliseconds << ','
+             << record.loadMilliseconds << ',' << record.solveMilliseconds << ',' << record.verifyMilliseconds << ','
+             << record.rvnsMilliseconds << ',' << record.evaluations << ',' << evaluationsPerSecond(record) << ','
+             << record.peakRSSKilobytes << ',' << record.gamma2r << ',' << (record.feasible ? "true" : "false") << '\n';
+    }
+}
+
+static void writeJSON(const std::string& filename, const std::vector<Record>& records, const Settings& settings) {
+    std::ofstream file(filename);
+
+    file << "{\n  \"commit\": \"" << DRD_COMMIT << "\",\n"
+         << "  \"parameters\": { \"population\": " << settings.populationSize << ", \"generations\": "
+         << settings.generations << ", \"ants\": " << settings.numberOfAnts << ", \"iterations\": "
+         << settings.iterations << ", \"tabu_iterations\": " << settings.tabuIterations << " },\n  \"runs\": [\n";
+
+    for (size_t i = 0; i < records.size(); ++i) {
+        const Record& record = records[i];
+        file << "    { \"instance\": \"" << record.instance << "\", \"family\": \"" << record.family
+             << "\", \"order\": " << record.order << ", \"size\": " << record.size
+             << ", \"algorithm\": \"" << record.algorithm << "\", \"seed\": " << record.seed
+             << ", \"wall_ms\": " << record.wallMilliseconds << ", \"load_ms\": " << record.loadMilliseconds
+             << ", \"solve_ms\": " << record.solveMilliseconds << ", \"verify_ms\": " << record.verifyMilliseconds
+             << ", \"rvns_ms\": " << record.rvnsMilliseconds << ", \"evaluations\": " << record.evaluations
+             << ", \"evaluations_per_second\": " << evaluationsPerSecond(record)
+             << ", \"peak_rss_kb\": " << record.peakRSSKilobytes << ", \"gamma2r\": " << record.gamma2r
+             << ", \"feasible\": " << (record.feasible ? "true" : "false") << " }"
+             << (i + 1 < records.size() ? ",\n" : "\n");
+    }
+
+    file << "  ]\n}\n";
+}
+
+static Settings parseSettings(int argc, char** argv) {
+    Settings settings;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc)
+                throw std::invalid_argument("Missing value for " + argument);
+            return argv[++i];
+        };
+
+        if (argument == "--quick") settings.quick = true;
+        else if (argument == "--seeds") settings.seeds = std::stoul(value());
+        else if (argument == "--instances") settings.instanceDirectory = value();
+        else if (argument == "--csv") settings.csvFile = value();
+        else if (argument == "--json") settings.jsonFile = value();
+        else if (argument == "--population") settings.populationSize = std::stoul(value());
+        else if (argument == "--generations") settings.generations = std::stoul(value());
+        else if (argument == "--ants") settings.numberOfAnts = std::stoul(value());
+        else if (argument == "--iterations") settings.iterations = std::stoul(value());
+        else if (argument == "--tabu-iterations") settings.tabuIterations = std::stoul(value());
+        else throw std::invalid_argument("Unknown option " + argument);
+    }
+
+    return settings;
+}
+
+int main(int argc, char** argv) {
+    Settings settings;
+
+    try {
+        settings = parseSettings(argc, argv);
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+
+    const std::vector<std::string> algorithms = { "heuristic1", "heuristic2", "heuristic3", "ga", "aco", "tabu" };
+    std::vector<Record> records;
+
+    std::cout << std::left << std::setw(24) << "instance" << std::setw(12) << "algorithm" << std::right
+              << std::setw(6) << "seed" << std::setw(12) << "wall(ms)" << std::setw(14) << "evals/s"
+              << std::setw(12) << "rss(kB)" << std::setw(9) << "gamma2R" << std::endl;
+
+    for (const auto& instance: buildCorpus(settings)) {
+        for (const auto& algorithm: algorithms) {
+            for (unsigned int seed = 1; seed <= settings.seeds; ++seed) {
+                Record record = runAlgorithm(instance, algorithm, seed, settings);
+                records.push_back(record);
+
+                std::cout << std::left << std::setw(24) << record.instance << std::setw(12) << record.algorithm
+                          << std::right << std::setw(6) << record.seed << std::setw(12) << std::fixed
+                          << std::setprecision(2) << record.wallMilliseconds << std::setw(14) << std::setprecision(0)
+                          << evaluationsPerSecond(record) << std::setw(12) << record.peakRSSKilobytes
+                          << std::setw(9) << record.gamma2r << (record.feasible ? "" : "  INFEASIBLE") << std::endl;
+            }
+        }
+    }
+
+    writeCSV(settings.csvFile, records);
+    writeJSON(settings.jsonFile, records, settings);
+
+    return 0;
+}
@@ -2,12 +2,107 @@
 #define ANT_COLONY_OPTIMIZATION_HPP
 
 #include "Graph.hpp"
+#include "DominationState.hpp"
+#include "PheromoneKernel.hpp"
+#include "SharedIncumbent.hpp"
+#include "Checkpoint.hpp"
+#include "CompactGraph.hpp"
+#include "LocalSearch.hpp"
+#include "ThreadPool.hpp"
 #include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <functional>
+#include <limits>
+#include <memory>
+
+struct RVNSStatistics {
+    size_t calls;
+    size_t iterations;
+    size_t improvements;
+    double elapsedMicroseconds;
+
+    RVNSStatistics(): calls(0), iterations(0), improvements(0), elapsedMicroseconds(0.0) {}
+
+    double getImprovementRate() const;
+    double getTimePerIteration() const;
+};
+
+enum class RestartPolicy { None, ResetPheromones, ResetPheromonesAndRestartBest };
+
+enum class StopReason { IterationLimit, NoImprovement, TimeBudget, TargetWeight, Cancelled, LowerBound };
+
+struct ACOStopCriteria {
+    size_t maxNoImprovementIterations;
+    double timeBudget;
+    size_t targetWeight;
+
+    ACOStopCriteria(): maxNoImprovementIterations(0), timeBudget(0.0), targetWeight(0) {}
+};
+
+/**
+ * When the colony restarts, as passed to AntColonyOptimization::setRestartPolicy; the defaults are
+ * those of a new colony.
+ */
+
+struct ACORestartSettings {
+    RestartPolicy policy;
+    float convergenceThreshold;
+    size_t noImprovementIterations;
+
+    ACORestartSettings(): policy(RestartPolicy::ResetPheromones), convergenceThreshold(0.99f),
+                          noImprovementIterations(0) {}
+
+    static RestartPolicy parse(const std::string& name);
+};
+
+/**
+ * Tunables of the ACO and its RVNS: pheromone evaporation and bounds, the share of 0/2 labels
+ * destroyed by RVNS (growing from the minimum to the maximum rate over `maxRVNSfunctions`
+ * neighborhoods) and its iteration limits, the share of 0/2 labels raised to 3 by ExtendSolution
+ * and the rebuild, and the probabilities that a construction step and an ExtendSolution step
+ * draw their vertex by pheromone roulette rather than taking the most attractive one.
+ */
+
+struct ACOParameters {
+    float evaporationRate;
+    float minPheromone;
+    float maxPheromone;
+    float minDestructionRate;
+    float maxDestructionRate;
+    size_t maxRVNSfunctions;
+    size_t maxRVNSiterations;
+    size_t maxRVNSnoImprovementIterations;
+    float addVerticesRate;
+    float selectionVertexRateConstructSolution;
+    float selectionVertexRateExtendSolution;
+
+    ACOParameters(): evaporationRate(0.2f), minPheromone(0.001f), maxPheromone(0.999f), minDestructionRate(0.2f),
+                     maxDestructionRate(0.5f), maxRVNSfunctions(5), maxRVNSiterations(150),
+                     maxRVNSnoImprovementIterations(10), addVerticesRate(0.05f),
+                     selectionVertexRateConstructSolution(0.7f), selectionVertexRateExtendSolution(0.9f) {}
+
+    void check() const;
+};
+
+struct ACOIterationTelemetry {
+    size_t iteration;
+    float convergenceFactor;
+    size_t iterationBestWeight;
+    size_t restartBestWeight;
+    size_t bestWeight;
+    double elapsedSeconds;
+    bool restarted;
+};
 
 class AntColonyOptimization {
     private:
         Graph graph;
-        std::vector<float> graphPheromone;
+        CompactGraph compactGraph;
+        std::vector<float> inverseCosts;
+        PheromoneVector graphPheromone;
+        PheromoneSummary pheromoneSummary;
         std::vector<int> solution;
         size_t numberOfAnts;
         size_t iterations;
@@ -16,60 +111,131 @@ class AntColonyOptimization {
         std::vector<int> bestSolution;
          
         float convergenceFactor;
-        float evaporationRate;
+        ACOParameters parameters;
 
-        float minDestructionRate;
-        float maxDestructionRate;
         size_t currentRVNSnumber;
-        size_t maxRVNSfunctions;
-        size_t maxRVNSiterations;
-        size_t maxRVNSnoImprovementIterations;
-
-
-        void initializePheromones(std::vector<float>& graphPheromone);
+        RVNSStatistics statisticsRVNS;
+        size_t numberOfRVNSThreads;
+        std::unique_ptr<ThreadPool> poolRVNS;
+        double timeBudgetRVNS;
+
+        ACOStopCriteria stopCriteria;
+        RestartPolicy restartPolicy;
+        float restartConvergenceThreshold;
+        size_t restartNoImprovementIterations;
+        StopReason stopReason;
+        size_t numberOfRestarts;
+        size_t evaluations;
+        std::vector<ACOIterationTelemetry> telemetry;
+        std::function<void(const ACOIterationTelemetry&)> iterationCallback;
+        const std::atomic<bool>* cancellationFlag;
+        std::chrono::steady_clock::time_point deadline;
+        SharedIncumbent* sharedIncumbent;
+        size_t lowerBound;
+        size_t noImprovementIterations;
+        size_t restartNoImprovement;
+        double resumedElapsedSeconds;
+        CheckpointWriter* checkpointWriter;
+        std::string checkpointPath;
+        size_t checkpointInterval;
+        ResumePoint resumePoint;
+        bool warmStarted;
+        bool localSearchEnabled;
+
+        void restart();
+        void saveCheckpoint(size_t iteration, double elapsedSeconds, bool finished);
+        bool exchangeIncumbent();
+        bool isCancelled() const;
+
+
+        void initializePheromones(PheromoneVector& graphPheromone);
         std::vector<int> constructSolution(std::vector<int> solution);
         std::vector<int> extendSolution(std::vector<int> solution);
         std::vector<int> reduceSolution(std::vector<int> solution);
         std::vector<int> RVNS(std::vector<int> solution);
                                                                        
-        std::vector<int> destroySolution(std::vector<int> solution);
-
+        std::vector<int> parallelRVNS(std::vector<int> solution);
+                                                                       
+        std::vector<size_t> destroySolution(DominationState& state, size_t neighborhood,
+                std::vector<std::pair<size_t, int>>& changes);
+        void rebuildSolution(DominationState& state, const std::vector<size_t>& destroyedVertices,
+                std::vector<std::pair<size_t, int>>& changes);
+        void relabel(DominationState& state, size_t vertex, int label,
+                std::vector<std::pair<size_t, int>>& changes);
+        size_t chooseResidualVertex(const DominationState& state, const std::vector<size_t>& residual,
+                std::mt19937& seed);
+
+        float attractiveness(size_t degree, size_t vertex) const;
+        bool reducedBefore(size_t a, size_t b) const;
         size_t chooseVertex(Graph& temp);
         size_t chooseVertex(std::vector<int> twoOrZeroLabeledVertices);
 
-        bool feasible(std::vector<int> solution);
+        bool feasible(const std::vector<int>& solution) const;
 
-        size_t summation(std::vector<int> solution);
+        size_t summation(const std::vector<int>& solution) const;
         
-        float getMaxPheromoneValue(std::vector<float> graphPheromone);
+        float getMaxPheromoneValue() const;
         
-        float getMinPheromoneValue(std::vector<float> graphPheromone);
+        float getMinPheromoneValue() const;
         
         bool delta(std::vector<int> solution, size_t vertex);
 
         void updatePheromones(std::vector<int>& currentBestSolution,
                 std::vector<int>& bestSolution,
-                std::vector<float>& graphPheromone);
+                PheromoneVector& graphPheromone);
 
-        float computeConvergence(std::vector<float> graphPheromone);
+        float computeConvergence() const;
         
         size_t rouletteWheelSelection(Graph& temp);
         size_t rouletteWheelSelection(std::vector<int> twoOrZeroLabeledVertices);
 
+        friend class KernelBenchmark;
+
     public:
 
         AntColonyOptimization(Graph& graph, size_t iterations, size_t numberOfAnts):
-             graph(graph), solution(graph.getOrder(), -1),
+             graph(graph), compactGraph(graph), inverseCosts(graph.getOrder(), 1.0f), solution(graph.getOrder(), -1),
              graphPheromone(graph.getOrder(), 0.0),
              numberOfAnts(numberOfAnts), iterations(iterations),
-             convergenceFactor(0), evaporationRate(0.2),
-             minDestructionRate(0.2), maxDestructionRate(0.5),
-             currentRVNSnumber(1), maxRVNSfunctions(5), maxRVNSiterations(150),
-             maxRVNSnoImprovementIterations(10), 
-             currentBestSolution(graph.getOrder(), 3), bestSolution(graph.getOrder(), 3) {}
+             convergenceFactor(0),
+             currentRVNSnumber(1), numberOfRVNSThreads(1), timeBudgetRVNS(0.0),
+             restartPolicy(RestartPolicy::ResetPheromones), restartConvergenceThreshold(0.99f),
+             restartNoImprovementIterations(0), stopReason(StopReason::IterationLimit), numberOfRestarts(0), evaluations(0), cancellationFlag(nullptr),
+             deadline(std::chrono::steady_clock::time_point::max()), sharedIncumbent(nullptr), lowerBound(0), noImprovementIterations(0), restartNoImprovement(0),
+             resumedElapsedSeconds(0.0), checkpointWriter(nullptr), checkpointInterval(0), warmStarted(false),
+             localSearchEnabled(false),
+             currentBestSolution(graph.getOrder(), 3), bestSolution(graph.getOrder(), 3) {
+                 for (size_t i = 0; i < this->inverseCosts.size(); ++i)
+                     this->inverseCosts[i] = 1.0f / graph.getCost(i);
+                 initializePheromones(this->graphPheromone);
+             }
 
         ~AntColonyOptimization() {} 
         std::vector<int> getBestSolution();
+        const RVNSStatistics& getRVNSStatistics() const;
+
+        void setIterations(size_t iterations);
+        void setRVNSThreads(size_t numberOfRVNSThreads);
+        void setRVNSTimeBudget(double milliseconds);
+        void setLocalSearch(bool enabled);
+        void setParameters(const ACOParameters& parameters);
+        const ACOParameters& getParameters() const;
+
+        void setStopCriteria(const ACOStopCriteria& stopCriteria);
+        void setRestartPolicy(RestartPolicy restartPolicy, float convergenceThreshold = 0.99f,
+                size_t noImprovementIterations = 0);
+        void setIterationCallback(std::function<void(const ACOIterationTelemetry&)> iterationCallback);
+        void setCancellationFlag(const std::atomic<bool>* cancellationFlag);
+        void setSharedIncumbent(SharedIncumbent* sharedIncumbent);
+        void setLowerBound(size_t lowerBound);
+        void setCheckpoint(CheckpointWriter* checkpointWriter, const std::string& path, size_t interval);
+        void resume(const std::string& path);
+        void warmStart(const Graph& graph, const std::vector<int>& solution);
+
+        StopReason getStopReason() const;
+        size_t getNumberOfRestarts() const;
+        size_t getNumberOfEvaluations() const;
+        const std::vector<ACOIterationTelemetry>& getTelemetry() const;
 
 
         void run();
@@ -0,0 +1,89 @@
+#ifndef ANYTIME_SOLVER_HPP
+#define ANYTIME_SOLVER_HPP
+
+#include "Graph.hpp"
+#include "GeneticAlgorithm.hpp"
+#include "AntColonyOptimization.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class SolverAlgorithm { GeneticAlgorithm, ACO, Both };
+
+struct SolverLimits {
+    double timeBudget;
+    size_t maxIterations;
+    size_t targetWeight;
+
+    SolverLimits(): timeBudget(0.0), maxIterations(0), targetWeight(0) {}
+};
+
+struct SolverIncumbent {
+    std::vector<int> solution;
+    size_t weight;
+    std::string algorithm;
+    size_t iteration;
+    double elapsedSeconds;
+};
+
+class AnytimeSolver {
+    private:
+        Graph graph;
+        size_t populationSize;
+        size_t generations;
+        short int heuristic;
+        size_t numberOfAnts;
+        size_t iterations;
+        size_t numberOfRVNSThreads;
+        size_t lowerBound;
+        SolverAlgorithm algorithm;
+        SolverLimits limits;
+        std::function<void(const SolverIncumbent&)> improvementCallback;
+
+        mutable std::mutex mutex;
+        std::condition_variable finishedCondition;
+        SolverIncumbent incumbent;
+        StopReason stopReason;
+        bool stopRequested;
+        bool finished;
+        std::atomic<bool> cancelled;
+        std::chrono::steady_clock::time_point startTime;
+        std::thread worker;
+        std::thread watchdog;
+
+        SolverIncumbent initialIncumbent() const;
+        void work();
+        void watch();
+        void offer(const std::vector<int>& solution, const char* algorithm, size_t iteration);
+        void requestStop(StopReason reason);
+        void join();
+
+    public:
+        AnytimeSolver(Graph& graph, size_t populationSize, size_t generations, short int heuristic,
+                size_t numberOfAnts, size_t iterations, size_t numberOfRVNSThreads = 1);
+        ~AnytimeSolver();
+
+        AnytimeSolver(const AnytimeSolver&) = delete;
+        AnytimeSolver& operator=(const AnytimeSolver&) = delete;
+
+        void setAlgorithm(SolverAlgorithm algorithm);
+        void setImprovementCallback(std::function<void(const SolverIncumbent&)> improvementCallback);
+
+        void start(const SolverLimits& limits);
+        SolverIncumbent solve(const SolverLimits& limits);
+        void cancel();
+        void wait();
+        bool waitFor(double seconds);
+
+        bool isRunning() const;
+        SolverIncumbent getIncumbent() const;
+        StopReason getStopReason() const;
+        size_t getLowerBound() const;
+};
+
+#endif
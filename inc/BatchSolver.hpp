@@ -0,0 +1,107 @@
+#ifndef BATCH_SOLVER_HPP
+#define BATCH_SOLVER_HPP
+
+#include "Graph.hpp"
+#include "AntColonyOptimization.hpp"
+#include "GeneticOperators.hpp"
+#include "TabuSearch.hpp"
+#include "ThreadPool.hpp"
+#include "Topology.hpp"
+#include "VertexOrdering.hpp"
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct BatchSettings {
+    std::string input;
+    std::string output;
+    std::vector<std::string> algorithms;
+    size_t seeds;
+    unsigned int firstSeed;
+    size_t populationSize;
+    size_t generations;
+    short int heuristic;
+    size_t numberOfAnts;
+    size_t iterations;
+    size_t numberOfThreads;
+    size_t smallGraphOrder;
+    size_t largeGraphOrder;
+    size_t largeGraphRVNSThreads;
+    size_t exactNodeLimit;
+    OrderingStrategy ordering;
+    bool directed;
+    GeneticOperators operators;
+    ACOParameters aco;
+    ACOStopCriteria stopACO;
+    ACORestartSettings restartACO;
+    double timeBudgetRVNS;
+    bool localSearchACO;
+    TabuSettings tabu;
+    double timeBudget;
+    AffinityPolicy affinity;
+    bool replicateGraph;
+
+    BatchSettings(): algorithms({ "ga", "aco" }), seeds(1), firstSeed(1), populationSize(100), generations(20),
+                     heuristic(1), numberOfAnts(10), iterations(10), numberOfThreads(0), smallGraphOrder(200),
+                     largeGraphOrder(2000), largeGraphRVNSThreads(4), exactNodeLimit(1000000),
+                     ordering(OrderingStrategy::Identity), directed(false), timeBudgetRVNS(0.0), localSearchACO(false),
+                     timeBudget(0.0),
+                     affinity(AffinityPolicy::None), replicateGraph(false) {}
+};
+
+struct BatchResult {
+    std::string graph;
+    size_t order;
+    size_t size;
+    std::string algorithm;
+    unsigned int seed;
+    size_t gamma2r;
+    size_t lowerBound;
+    bool feasible;
+    double loadMilliseconds;
+    double solveMilliseconds;
+    size_t worker;
+    size_t node;
+};
+
+class BatchSolver {
+    private:
+        BatchSettings settings;
+        std::ofstream output;
+        std::mutex outputMutex;
+        size_t numberOfResults;
+        size_t numberOfFailures;
+        size_t numberOfFailedTasks;
+        ThreadPool pool;
+
+        void loadAndSchedule(const std::string& path);
+        void solveTasks(std::shared_ptr<NodeReplicas<Graph>> graph, const std::string& path, double loadMilliseconds,
+                const std::vector<std::pair<std::string, unsigned int>>& tasks, size_t numberOfRVNSThreads);
+        BatchResult solve(Graph& graph, const std::string& algorithm, unsigned int seed, size_t numberOfRVNSThreads);
+        void write(const BatchResult& result);
+
+        static std::vector<int> runAlgorithm(const BatchSettings& settings, Graph& graph, const std::string& algorithm,
+                size_t numberOfRVNSThreads);
+        static std::vector<int> solveComponent(const BatchSettings& settings, Graph& component,
+                const std::string& algorithm, size_t numberOfRVNSThreads);
+
+    public:
+        explicit BatchSolver(const BatchSettings& settings);
+
+        BatchSolver(const BatchSolver&) = delete;
+        BatchSolver& operator=(const BatchSolver&) = delete;
+
+        size_t run();
+        size_t getNumberOfFailures() const;
+        size_t getNumberOfFailedTasks() const;
+
+        static std::vector<std::string> listGraphs(const std::string& input);
+        static void checkSettings(const BatchSettings& settings);
+        static std::vector<int> solveGraph(const BatchSettings& settings, Graph& graph, const std::string& algorithm,
+                size_t numberOfRVNSThreads);
+};
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include "Graph.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+enum class CheckpointKind : uint32_t { GeneticAlgorithm = 1, ACO = 2 };
+
+struct CheckpointSettings {
+    std::string path;
+    size_t interval;
+    bool resume;
+
+    CheckpointSettings(): interval(10), resume(false) {}
+
+    static CheckpointSettings fromEnvironment();
+};
+
+/**
+ * Where a loaded checkpoint resumes a run: the next generation or iteration, whether the run had
+ * already finished and the state of the random engine of the thread that ran it.
+ */
+
+struct ResumePoint {
+    bool pending;
+    bool finished;
+    size_t step;
+    std::mt19937 engine;
+
+    ResumePoint(): pending(false), finished(false), step(0) {}
+};
+
+class CheckpointBuffer {
+    private:
+        std::vector<char> bytes;
+
+    public:
+        CheckpointBuffer(CheckpointKind kind, const Graph& graph);
+
+        template <typename T>
+        void write(const T& value) {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values are written as bytes");
+            const char* data = reinterpret_cast<const char*>(&value);
+            this->bytes.insert(this->bytes.end(), data, data + sizeof(T));
+        }
+
+        template <typename T, typename Allocator>
+        void writeVector(const std::vector<T, Allocator>& values) {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values are written as bytes");
+            this->write<uint64_t>(values.size());
+            const char* data = reinterpret_cast<const char*>(values.data());
+            this->bytes.insert(this->bytes.end(), data, data + values.size() * sizeof(T));
+        }
+
+        void writeEngine(const std::mt19937& engine);
+
+        std::vector<char>& getBytes();
+};
+
+class CheckpointReader {
+    private:
+        std::string path;
+        std::vector<char> bytes;
+        size_t offset;
+
+        void require(size_t length);
+
+    public:
+        CheckpointReader(const std::string& path, CheckpointKind kind, const Graph& graph);
+
+        template <typename T>
+        T read() {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values are read as bytes");
+            T value;
+            this->require(sizeof(T));
+            std::memcpy(&value, this->bytes.data() + this->offset, sizeof(T));
+            this->offset += sizeof(T);
+            return value;
+        }
+
+        template <typename T, typename Allocator>
+        void readVector(std::vector<T, Allocator>& values) {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values are read as bytes");
+            uint64_t length = this->read<uint64_t>();
+            if (length > (this->bytes.size() - this->offset) / sizeof(T))
+                throw std::runtime_error("Truncated checkpoint " + this->path);
+            values.resize(length);
+            std::memcpy(values.data(), this->bytes.data() + this->offset, length * sizeof(T));
+            this->offset += length * sizeof(T);
+        }
+
+        void readEngine(std::mt19937& engine);
+
+        static bool exists(const std::string& path);
+};
+
+class CheckpointWriter {
+    private:
+        std::map<std::string, std::vector<char>> pending;
+        std::thread worker;
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool writing;
+        bool stopping;
+        size_t numberOfWrites;
+
+        void workerLoop();
+
+    public:
+        CheckpointWriter(): writing(false), stopping(false), numberOfWrites(0) {}
+        ~CheckpointWriter();
+
+        CheckpointWriter(const CheckpointWriter&) = delete;
+        CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+        void submit(const std::string& path, std::vector<char>&& bytes);
+        void flush();
+
+        size_t getNumberOfWrites();
+};
+
+#endif
@@ -20,7 +20,9 @@ struct Chromosome {
 
 	Chromosome(std::vector<int> primeiraMetade, std::vector<int> segundaMetade);
     
-    Chromosome(const Chromosome& chromosome);
+    Chromosome(const Chromosome& chromosome) = default;
+
+    Chromosome& operator=(const Chromosome& chromosome) = default;
         
 	~Chromosome() {};
 
@@ -0,0 +1,60 @@
+#ifndef COMPACT_GRAPH_HPP
+#define COMPACT_GRAPH_HPP
+
+#include "Graph.hpp"
+#include <cstdint>
+#include <vector>
+
+class NeighborRange {
+    private:
+        const uint32_t* first;
+        const uint32_t* last;
+
+    public:
+        NeighborRange(const uint32_t* first, const uint32_t* last): first(first), last(last) {}
+
+        const uint32_t* begin() const { return first; }
+        const uint32_t* end() const { return last; }
+        size_t size() const { return last - first; }
+};
+
+/**
+ * Read-only graph backend in compressed sparse row form: the neighbors of all vertices are stored
+ * back to back in one array of 32-bit ids, with an offset per vertex, so the neighborhood scans of
+ * the repair and feasibility kernels read contiguous memory, half as wide as Graph's size_t lists.
+ * It has the same neighborhood accessors as Graph, so the kernels take either as a template
+ * parameter.
+ */
+
+class CompactGraph {
+    private:
+        size_t order;
+        bool isDirected;
+        std::vector<uint32_t> outOffsets;
+        std::vector<uint32_t> outTargets;
+        std::vector<uint32_t> inOffsets;
+        std::vector<uint32_t> inTargets;
+        std::vector<size_t> costs;
+
+    public:
+        explicit CompactGraph(const Graph& graph);
+
+        size_t getOrder() const { return order; }
+        bool isDirectedGraph() const { return isDirected; }
+
+        NeighborRange getAdjacencyList(size_t vertex) const {
+            return { outTargets.data() + outOffsets[vertex], outTargets.data() + outOffsets[vertex + 1] };
+        }
+
+        NeighborRange getInNeighbors(size_t vertex) const {
+            if (!isDirected)
+                return getAdjacencyList(vertex);
+            return { inTargets.data() + inOffsets[vertex], inTargets.data() + inOffsets[vertex + 1] };
+        }
+
+        size_t getVertexDegree(size_t vertex) const { return outOffsets[vertex + 1] - outOffsets[vertex]; }
+
+        size_t getCost(size_t vertex) const { return costs[vertex]; }
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef CONFIGURATION_HPP
+#define CONFIGURATION_HPP
+
+#include "BatchSolver.hpp"
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * Options of the flag front end: `--key value`, `--key=value` or a bare `--key` (true) on the
+ * command line, and `key = value` lines in the file named by `--config`, where `#` starts a
+ * comment. Flags override the file. Each option is read once by a typed getter, and checkUnused()
+ * rejects the options no getter asked for, so a misspelt key is an error rather than a default.
+ */
+
+class Configuration {
+    private:
+        std::map<std::string, std::string> values;
+        std::set<std::string> used;
+
+        void load(const std::string& path);
+        const std::string* find(const std::string& key);
+
+    public:
+        Configuration(int argc, char** argv, int first);
+
+        std::string getString(const std::string& key, const std::string& value);
+        size_t getSize(const std::string& key, size_t value, size_t minimum = 0,
+                size_t maximum = std::numeric_limits<size_t>::max());
+        double getDouble(const std::string& key, double value);
+        bool getBool(const std::string& key, bool value);
+        std::vector<std::string> getList(const std::string& key, const std::vector<std::string>& value);
+
+        void apply(BatchSettings& settings);
+        void checkUnused() const;
+};
+
+#endif
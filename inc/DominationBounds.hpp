@@ -0,0 +1,17 @@
+#ifndef DOMINATION_BOUNDS_HPP
+#define DOMINATION_BOUNDS_HPP
+
+#include "Graph.hpp"
+#include <vector>
+
+class DominationBounds {
+    public:
+        static double coverageCost(size_t degree);
+        static double coverageCost(const Graph& graph, size_t vertex);
+
+        static size_t degreeBound(const Graph& graph);
+        static double fractionalBound(const Graph& graph, const std::vector<size_t>& vertices);
+        static size_t lowerBound(const Graph& graph);
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef DOMINATION_STATE_HPP
+#define DOMINATION_STATE_HPP
+
+#include "Graph.hpp"
+#include <vector>
+
+class DominationState {
+    private:
+        const Graph* graph;
+        std::vector<int> labels;
+        std::vector<size_t> neighborsLabeled3;
+        std::vector<size_t> neighborsLabeled2;
+        size_t weight;
+
+        static bool dominated(int label, size_t labeled3, size_t labeled2);
+        void countArc(size_t source, size_t destination, bool added);
+
+    public:
+        DominationState(const Graph& graph, const std::vector<int>& labels);
+        ~DominationState() = default;
+
+        int getLabel(size_t vertex) const;
+        size_t getWeight() const;
+        const std::vector<int>& getLabels() const;
+
+        void setLabel(size_t vertex, int label);
+        void edgeAdded(size_t source, size_t destination);
+        void edgeRemoved(size_t source, size_t destination);
+
+        bool isDominated(size_t vertex) const;
+        bool canRelabel(size_t vertex, int label) const;
+        int undominatedDelta(size_t vertex, int label) const;
+        int undominatedDeltaAt(size_t observer, size_t vertex, int label) const;
+};
+
+#endif
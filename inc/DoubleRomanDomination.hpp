@@ -5,38 +5,82 @@
 #include "GeneticAlgorithm.hpp"
 #include "Chromosome.hpp"
 #include "AntColonyOptimization.hpp"
+#include "SharedIncumbent.hpp"
+#include "DominationBounds.hpp"
+#include "Checkpoint.hpp"
+#include <memory>
 #include <vector>
 #include <random>
 
+enum class ExecutionMode { Sequential, Hybrid };
+
 class DoubleRomanDomination {
 	private:
     	Graph graph;
-    	GeneticAlgorithm* geneticAlgorithm;
-    	AntColonyOptimization* ACO;
+    	std::unique_ptr<GeneticAlgorithm> geneticAlgorithm;
+    	std::unique_ptr<AntColonyOptimization> ACO;
 		std::vector<int> solutionACO;
         std::vector<int> solutionGeneticAlgorithm;
         size_t gamma2rGeneticAlgorithm;		
         size_t gamma2rACO;        
+        size_t lowerBound;
+        double millisecondsGeneticAlgorithm;
+        double millisecondsACO;
+        CheckpointWriter checkpointWriter;
+
+        void setCheckpoint(const CheckpointSettings& checkpoint);
+        void setLimits(double timeBudget, ACOStopCriteria stopCriteriaACO);
 	public:
 		DoubleRomanDomination(Graph& graph, size_t populationSize, size_t genesSize,
 		 	size_t generations, short int heuristic,
-			size_t numberOfAnts, size_t iterations) 
+			size_t numberOfAnts, size_t iterations, size_t numberOfRVNSThreads = 1,
+			ExecutionMode executionMode = ExecutionMode::Sequential,
+			const CheckpointSettings& checkpoint = CheckpointSettings(),
+			const GeneticOperators& operators = GeneticOperators(),
+			bool localSearchACO = false,
+			const ACOParameters& parametersACO = ACOParameters(),
+			double timeBudget = 0.0,
+			const ACOStopCriteria& stopCriteriaACO = ACOStopCriteria(),
+			const ACORestartSettings& restartACO = ACORestartSettings(),
+			double timeBudgetRVNS = 0.0) 
     			: graph(graph), gamma2rGeneticAlgorithm(0), gamma2rACO(0),   
+                lowerBound(DominationBounds::lowerBound(graph)),
+                millisecondsGeneticAlgorithm(0.0), millisecondsACO(0.0),
                 geneticAlgorithm(new GeneticAlgorithm(graph, populationSize, genesSize, generations)),
     		    ACO(new AntColonyOptimization(graph, iterations, numberOfAnts)) {    		       		
-                    this->runGeneticAlgorithm(heuristic);                    
-                    this->runACO();
+                    this->ACO->setRVNSThreads(numberOfRVNSThreads);
+                    this->geneticAlgorithm->setLowerBound(this->lowerBound);
+                    this->ACO->setLowerBound(this->lowerBound);
+                    this->geneticAlgorithm->setOperators(operators);
+                    this->ACO->setLocalSearch(localSearchACO);
+                    this->ACO->setParameters(parametersACO);
+                    this->ACO->setRestartPolicy(restartACO.policy, restartACO.convergenceThreshold,
+                                                restartACO.noImprovementIterations);
+                    this->ACO->setRVNSTimeBudget(timeBudgetRVNS);
+                    this->setLimits(timeBudget, stopCriteriaACO);
+                    this->setCheckpoint(checkpoint);
+                    if (executionMode == ExecutionMode::Hybrid)
+                        this->runHybrid(heuristic);
+                    else {
+                        this->runGeneticAlgorithm(heuristic);                    
+                        this->runACO();
+                    }
+                    this->checkpointWriter.flush();
                 }
 
-        ~DoubleRomanDomination();
         Graph& getGraph();
         std::vector<int> getSolutionACO();
         std::vector<int> getSolutionGeneticAlgorithm();
         size_t getGamma2rGeneticAlgorithm();
         size_t getGamma2rACO();
+        size_t getLowerBound();
+        double getMillisecondsGeneticAlgorithm();
+        double getMillisecondsACO();
+        const RVNSStatistics& getRVNSStatisticsACO();
 
         void runGeneticAlgorithm(short int heuristic);
         void runACO();
+        void runHybrid(short int heuristic);
 
         static Chromosome heuristic1(Graph graph);
         static Chromosome heuristic2(Graph graph);
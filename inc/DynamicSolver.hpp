@@ -0,0 +1,81 @@
+#ifndef DYNAMIC_SOLVER_HPP
+#define DYNAMIC_SOLVER_HPP
+
+#include "Graph.hpp"
+#include "DominationState.hpp"
+#include "GeneticAlgorithm.hpp"
+#include "AntColonyOptimization.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * One change of a dynamic graph: the edge {source, destination}, or the arc (source, destination)
+ * on a directed graph, is added or removed.
+ */
+
+struct EdgeDelta {
+    size_t source;
+    size_t destination;
+    bool added;
+};
+
+struct DynamicSettings {
+    size_t populationSize;
+    size_t generations;
+    short int heuristic;
+    size_t numberOfAnts;
+    size_t iterations;
+    size_t updateGenerations;
+    size_t updateIterations;
+    GeneticOperators operators;
+
+    DynamicSettings(): populationSize(100), generations(20), heuristic(1), numberOfAnts(10), iterations(10),
+                       updateGenerations(2), updateIterations(1) {}
+};
+
+struct UpdateStatistics {
+    size_t addedEdges;
+    size_t removedEdges;
+    size_t affectedVertices;
+    size_t repairedVertices;
+    size_t repairedWeight;
+    size_t weight;
+    double repairMilliseconds;
+    double searchMilliseconds;
+
+    UpdateStatistics(): addedEdges(0), removedEdges(0), affectedVertices(0), repairedVertices(0), repairedWeight(0),
+                        weight(0), repairMilliseconds(0.0), searchMilliseconds(0.0) {}
+};
+
+class DynamicSolver {
+    private:
+        DynamicSettings settings;
+        Graph graph;
+        DominationState state;
+        GeneticAlgorithm geneticAlgorithm;
+        AntColonyOptimization ACO;
+        UpdateStatistics statistics;
+
+        bool repair(size_t vertex, std::vector<size_t>& raised);
+        void reduce(std::vector<size_t>& candidates);
+        void search(size_t generations, size_t iterations, bool warm);
+        void adopt(const std::vector<int>& solution);
+
+    public:
+        DynamicSolver(const Graph& graph, const DynamicSettings& settings);
+        DynamicSolver(const Graph& graph, const std::vector<int>& solution, const DynamicSettings& settings);
+
+        DynamicSolver(const DynamicSolver&) = delete;
+        DynamicSolver& operator=(const DynamicSolver&) = delete;
+
+        size_t update(const std::vector<EdgeDelta>& deltas);
+
+        const Graph& getGraph() const;
+        const std::vector<int>& getSolution() const;
+        size_t getWeight() const;
+        const UpdateStatistics& getStatistics() const;
+
+        static std::vector<std::vector<EdgeDelta>> readDeltas(const std::string& filename);
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef EXACT_SOLVER_HPP
+#define EXACT_SOLVER_HPP
+
+#include "Graph.hpp"
+#include <cstdint>
+#include <vector>
+
+struct ExactResult {
+    std::vector<int> solution;
+    size_t weight;
+    size_t lowerBound;
+    bool optimal;
+    size_t nodes;
+};
+
+class ExactSolver {
+    private:
+        size_t order;
+        std::vector<uint64_t> neighborhoods;
+        std::vector<size_t> degrees;
+        std::vector<size_t> costs;
+        size_t rootBound;
+        size_t maxNodes;
+        size_t nodes;
+        bool aborted;
+
+        std::vector<int> labels;
+        std::vector<int> caps;
+        uint64_t labeled3;
+        uint64_t labeled2;
+
+        std::vector<int> bestSolution;
+        size_t bestWeight;
+
+        bool isDominated(size_t vertex) const;
+        void setLabel(size_t vertex, int label);
+        double residualBound(std::vector<double>& deficits, bool& infeasible) const;
+        void branch(size_t weight);
+        void greedy();
+
+    public:
+        static const size_t maxOrder = 64;
+
+        explicit ExactSolver(const Graph& graph, size_t maxNodes = 0);
+
+        void setUpperBound(const std::vector<int>& solution);
+        ExactResult solve();
+};
+
+#endif
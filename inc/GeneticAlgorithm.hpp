@@ -2,9 +2,16 @@
 #define GENETIC_ALGORITHM_HPP
 
 #include <iostream>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <random>
+#include <stdexcept>
 #include <vector>
 #include "Chromosome.hpp"
+#include "SharedIncumbent.hpp"
+#include "Checkpoint.hpp"
+#include "GeneticKernel.hpp"
 
 class GeneticAlgorithm {
 	private:
@@ -14,29 +21,40 @@ class GeneticAlgorithm {
 	    size_t generations;
         Graph graph;
         std::vector<int> bestSolution;
+        size_t evaluations;
+        std::function<void(size_t, const std::vector<int>&)> generationCallback;
+        const std::atomic<bool>* cancellationFlag;
+        double timeBudget;
+        SharedIncumbent* sharedIncumbent;
+        size_t injectedWeight;
+        size_t lowerBound;
+        CheckpointWriter* checkpointWriter;
+        std::string checkpointPath;
+        size_t checkpointInterval;
+        ResumePoint resumePoint;
+        Chromosome resumedBestSolution;
+        GeneticOperators operators;
+        std::unique_ptr<GenerationKernel> kernel;
+        bool warmStarted;
+        std::vector<int> warmStartSolution;
 
-		void createPopulation(Chromosome(*heuristic)(Graph), Graph graph);
-		
-		Chromosome crossOver(Chromosome& chromosome1, Chromosome& cromossomo2,
-                	Chromosome(*crossOverHeuristic)(Chromosome&, Chromosome&)); 
-                
-		Chromosome feasibilityCheck(Chromosome& chromosome);
-		
-		std::vector<Chromosome>& createNewPopulation();
-		
-        Chromosome selectionMethod(Chromosome(*selectionHeuristic)(std::vector<Chromosome>)); 
-        	
-        static Chromosome fitness(Chromosome& chromosome, Chromosome(*fitnessHeuristic)(Chromosome&));
-		static Chromosome tournamentSelection(std::vector<Chromosome> population);
-		static Chromosome rouletteWheelSelection(std::vector<Chromosome> population); 
-		static Chromosome chooseBestSolution(const Chromosome& chromosome1, const Chromosome& chromosome2);
-        static Chromosome chooseWorstSolution(const Chromosome& chromosome1, const Chromosome& chromosome2);
+		void exchangeIncumbent(Chromosome& bestSolution);
+		void saveCheckpoint(size_t generation, const Chromosome& bestSolution, bool finished);
+
+        const Chromosome& lightestChromosome() const;
+        Chromosome& heaviestChromosome();
 		
 	public:
 		GeneticAlgorithm(Graph& graph, size_t populationSize, size_t genesSize, size_t generations):
         				populationSize(populationSize), genesSize(genesSize),
                         generations(generations), population(populationSize),
-                        graph(graph) {}                 
+                        graph(graph), evaluations(0), cancellationFlag(nullptr), timeBudget(0.0),
+                        sharedIncumbent(nullptr), injectedWeight(0), lowerBound(0),
+                        checkpointWriter(nullptr), checkpointInterval(0), warmStarted(false) {
+                            // Selection draws two distinct parents from the population.
+                            if (populationSize < 2)
+                                throw std::invalid_argument("The genetic algorithm needs a population of at least 2");
+                        }
 
 		~GeneticAlgorithm() {}
 		
@@ -46,8 +64,20 @@ class GeneticAlgorithm {
 		size_t getGenesSize();
 		size_t getGenerations();   
         std::vector<int> getBestSolution();		      
+        size_t getNumberOfEvaluations();
+        GeneticOperators getOperators();
+
+        void setGenerationCallback(std::function<void(size_t, const std::vector<int>&)> generationCallback);
+        void setCancellationFlag(const std::atomic<bool>* cancellationFlag);
+        void setTimeBudget(double seconds);
+        void setSharedIncumbent(SharedIncumbent* sharedIncumbent);
+        void setLowerBound(size_t lowerBound);
+        void setCheckpoint(CheckpointWriter* checkpointWriter, const std::string& path, size_t interval);
+        void resume(const std::string& path);
+        void warmStart(const Graph& graph, const std::vector<int>& solution);
+        void setOperators(const GeneticOperators& operators);
 
-		void run(size_t generations, Chromosome(*heuristic)(Graph));
+		void run(size_t generations);
 };	
 
 #endif
@@ -0,0 +1,171 @@
+#ifndef GENETIC_KERNEL_HPP
+#define GENETIC_KERNEL_HPP
+
+#include "GeneticOperators.hpp"
+#include "LocalSearch.hpp"
+#include "Random.hpp"
+#include "Profiler.hpp"
+#include <memory>
+#include <numeric>
+
+/**
+ * The per-generation work of the genetic algorithm behind one virtual call, so that the operators
+ * inside it are resolved at compile time. Instances come from GeneticKernelFactory.
+ */
+
+class GenerationKernel {
+    public:
+        virtual ~GenerationKernel() = default;
+
+        virtual void createPopulation(std::vector<Chromosome>& population, size_t populationSize) = 0;
+        virtual size_t nextGeneration(std::vector<Chromosome>& population, size_t populationSize) = 0;
+        virtual size_t repair(Chromosome& chromosome) = 0;
+};
+
+template <class Selection, class Crossover, template <class> class Repair, class Construction, class Backend>
+class SpecializedGenerationKernel : public GenerationKernel {
+    private:
+        static constexpr size_t block = 64;
+
+        const Graph& graph;
+        Backend backend;
+        std::vector<size_t> pool;
+        std::vector<Chromosome> offspring;
+        std::vector<std::pair<size_t, size_t>> parents;
+        std::vector<typename Crossover::Plan> plans;
+        std::vector<int8_t> children;
+        std::vector<size_t> weights;
+        std::vector<const int*> rows;
+        std::vector<size_t> kept;
+        std::vector<int8_t> scratch;
+        std::unique_ptr<LocalSearch> localSearch;
+        float tournamentProbability;
+
+    public:
+        explicit SpecializedGenerationKernel(const Graph& graph, bool memetic = false,
+                                             float tournamentProbability = TournamentSelection::defaultBestProbability)
+            : graph(graph), backend(graph), localSearch(memetic ? new LocalSearch(graph) : nullptr),
+              tournamentProbability(tournamentProbability) {}
+
+        void createPopulation(std::vector<Chromosome>& population, size_t populationSize) override {
+            population.resize(populationSize);
+
+            for (size_t i = 0; i < populationSize; ++i) {
+                population[i] = Construction::create(this->graph);
+                population[i].indexRemove = i;
+                population[i].fitnessValue = this->graph.getWeight(population[i].genes);
+            }
+        }
+
+        /**
+         * Replaces the population by its offspring: each pair of parents, drawn without
+         * replacement from the pool (refilled with the whole population when fewer than two are
+         * left), is recombined into two children, both repaired, and the lighter child is kept,
+         * after a local search in a memetic kernel.
+         *
+         * The generation runs in passes over the whole population. The first draws every parent
+         * pair and crossover plan, in the order a pair-by-pair loop would draw them, so seeded runs
+         * are unchanged. The second writes all children into one packed matrix of bytes, stored
+         * vertex-major (the labels of a vertex in every child are contiguous), and the third repairs
+         * them together with Repair::applyColumns, which reads each neighbor list once per
+         * generation instead of once per child. The lighter child of each pair is then unpacked
+         * into the offspring. Every buffer is reused from one generation to the next.
+         *
+         * @return size_t The number of repaired children.
+         */
+
+        size_t nextGeneration(std::vector<Chromosome>& population, size_t populationSize) override {
+            PROFILE_SCOPE("GA::generation");
+            std::mt19937& engine = Random::engine();
+            size_t order = population.empty() ? 0 : population[0].genes.size();
+            size_t width = 2 * populationSize;
+
+            this->offspring.resize(populationSize);
+            this->parents.resize(populationSize);
+            this->plans.resize(populationSize);
+            this->pool.clear();
+
+            for (size_t k = 0; k < populationSize; ++k) {
+                if (this->pool.size() < 2) {
+                    this->pool.resize(population.size());
+                    std::iota(this->pool.begin(), this->pool.end(), size_t(0));
+                }
+
+                this->parents[k] = Selection::selectParents(population, this->pool, engine, this->tournamentProbability);
+                Crossover::draw(this->plans[k], order, engine);
+            }
+
+            this->rows.resize(width);
+            for (size_t k = 0; k < populationSize; ++k) {
+                this->rows[2 * k] = population[this->parents[k].first].genes.data();
+                this->rows[2 * k + 1] = population[this->parents[k].second].genes.data();
+            }
+
+            // Blocks of `block` vertices keep the block's columns in L1 while every parent row streams through.
+            this->children.resize(order * width);
+            for (size_t start = 0; start < order; start += block) {
+                size_t end = std::min(order, start + block);
+
+                for (size_t k = 0; k < populationSize; ++k) {
+                    const int* first = this->rows[2 * k];
+                    const int* second = this->rows[2 * k + 1];
+                    int8_t* cell = this->children.data() + start * width + 2 * k;
+
+                    for (size_t i = start; i < end; ++i, cell += width) {
+                        bool swaps = Crossover::swaps(this->plans[k], i);
+                        cell[0] = static_cast<int8_t>(swaps ? second[i] : first[i]);
+                        cell[1] = static_cast<int8_t>(swaps ? first[i] : second[i]);
+                    }
+                }
+            }
+
+            this->weights.resize(width);
+            Repair<Backend>::applyColumns(this->backend, this->children.data(), order, width, this->weights.data(),
+                                          this->scratch);
+
+            this->kept.resize(populationSize);
+            for (size_t k = 0; k < populationSize; ++k) {
+                this->kept[k] = this->weights[2 * k + 1] < this->weights[2 * k] ? 2 * k + 1 : 2 * k;
+                this->offspring[k].genes.resize(order);
+            }
+
+            for (size_t start = 0; start < order; start += block) {
+                size_t end = std::min(order, start + block);
+
+                for (size_t k = 0; k < populationSize; ++k) {
+                    int* genes = this->offspring[k].genes.data();
+                    const int8_t* cell = this->children.data() + start * width + this->kept[k];
+
+                    for (size_t i = start; i < end; ++i, cell += width)
+                        genes[i] = *cell;
+                }
+            }
+
+            for (size_t k = 0; k < populationSize; ++k) {
+                Chromosome& child = this->offspring[k];
+                size_t weight = this->weights[this->kept[k]];
+
+                if (this->localSearch)
+                    weight = this->localSearch->improve(child.genes);
+
+                child.genesSize = order;
+                child.indexRemove = k;
+                child.fitnessValue = weight;
+            }
+
+            population.swap(this->offspring);
+            return width;
+        }
+
+        size_t repair(Chromosome& chromosome) override {
+            chromosome.fitnessValue = Repair<Backend>::apply(this->backend, chromosome.genes);
+            return chromosome.fitnessValue;
+        }
+};
+
+class GeneticKernelFactory {
+    public:
+        static std::unique_ptr<GenerationKernel> create(const GeneticOperators& operators, const Graph& graph);
+};
+
+#endif
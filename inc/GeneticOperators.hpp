@@ -0,0 +1,343 @@
+#ifndef GENETIC_OPERATORS_HPP
+#define GENETIC_OPERATORS_HPP
+
+#include "Chromosome.hpp"
+#include "CompactGraph.hpp"
+#include "Graph.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Operators of the genetic algorithm as policy classes with static members, plugged into
+ * SpecializedGenerationKernel as template parameters so the generation loop calls them directly
+ * and the compiler can inline them. Fitness is the weight of a chromosome: lower is better.
+ *
+ * Selection policies pick parents from `pool`, the indices of the population still available in
+ * this generation, and remove them from it, so a parent is drawn at most once until the pool is
+ * refilled. Crossover policies draw a plan of the genes two parents exchange, which the kernel
+ * applies while building the children. Repair policies are templates over the graph backend (Graph
+ * or CompactGraph) and make a labeling a double Roman dominating function, returning its weight.
+ * Construction policies create the chromosomes of the first population. The improvement, "none"
+ * or "local-search", is not a policy: a memetic kernel runs LocalSearch on every child it keeps,
+ * at a cost far above the per-gene work the policies inline.
+ */
+
+struct GeneticOperators {
+    std::string selection;
+    std::string crossover;
+    std::string backend;
+    std::string improvement;
+    short int heuristic;
+    float tournamentProbability;
+
+    GeneticOperators(): selection("mixed"), crossover("two-point"), backend("compact"), improvement("none"),
+                        heuristic(1), tournamentProbability(0.75f) {}
+
+    void check() const;
+
+    static GeneticOperators parse(const std::string& specification);
+};
+
+namespace SelectionDetail {
+
+inline size_t take(std::vector<size_t>& pool, size_t position) {
+    size_t index = pool[position];
+    pool[position] = pool.back();
+    pool.pop_back();
+    return index;
+}
+
+}
+
+struct TournamentSelection {
+    static constexpr float defaultBestProbability = 0.75f;
+
+    /**
+     * Binary tournament: of two random members of the pool, the lighter wins with probability
+     * `bestProbability`, the heavier otherwise.
+     */
+
+    static size_t select(const std::vector<Chromosome>& population, std::vector<size_t>& pool, std::mt19937& engine,
+                         float bestProbability = defaultBestProbability) {
+        std::uniform_int_distribution<size_t> gap(0, pool.size() - 1);
+        std::uniform_real_distribution<float> probability(0.0f, 1.0f);
+
+        size_t first = gap(engine);
+        size_t second = gap(engine);
+        bool firstIsLighter = population[pool[first]].fitnessValue <= population[pool[second]].fitnessValue;
+
+        return SelectionDetail::take(pool, (probability(engine) < bestProbability) == firstIsLighter ? first : second);
+    }
+
+    static std::pair<size_t, size_t> selectParents(const std::vector<Chromosome>& population, std::vector<size_t>& pool,
+                                                   std::mt19937& engine, float bestProbability = defaultBestProbability) {
+        size_t first = select(population, pool, engine, bestProbability);
+        return { first, select(population, pool, engine, bestProbability) };
+    }
+};
+
+struct RouletteWheelSelection {
+    /**
+     * Fitness-proportionate selection for minimization: a member of the pool is drawn with
+     * probability proportional to (heaviest weight in the pool - its weight + 1).
+     */
+
+    static size_t select(const std::vector<Chromosome>& population, std::vector<size_t>& pool, std::mt19937& engine) {
+        size_t heaviest = 0;
+        for (const auto& index: pool)
+            heaviest = std::max(heaviest, population[index].fitnessValue);
+
+        size_t total = 0;
+        for (const auto& index: pool)
+            total += heaviest - population[index].fitnessValue + 1;
+
+        size_t value = std::uniform_int_distribution<size_t>(0, total - 1)(engine);
+        size_t position = 0;
+
+        for (size_t cumulative = 0; position + 1 < pool.size(); ++position) {
+            cumulative += heaviest - population[pool[position]].fitnessValue + 1;
+            if (value < cumulative)
+                break;
+        }
+
+        return SelectionDetail::take(pool, position);
+    }
+
+    /**
+     * Takes the tournament probability like the other selections, and ignores it.
+     */
+
+    static std::pair<size_t, size_t> selectParents(const std::vector<Chromosome>& population, std::vector<size_t>& pool,
+                                                   std::mt19937& engine, float = TournamentSelection::defaultBestProbability) {
+        size_t first = select(population, pool, engine);
+        return { first, select(population, pool, engine) };
+    }
+};
+
+/**
+ * The original pairing of the algorithm: one parent by tournament, the other by roulette wheel.
+ */
+
+struct MixedSelection {
+    static std::pair<size_t, size_t> selectParents(const std::vector<Chromosome>& population, std::vector<size_t>& pool,
+                                                   std::mt19937& engine,
+                                                   float bestProbability = TournamentSelection::defaultBestProbability) {
+        size_t first = TournamentSelection::select(population, pool, engine, bestProbability);
+        return { first, RouletteWheelSelection::select(population, pool, engine) };
+    }
+};
+
+struct TwoPointCrossover {
+    struct Plan {
+        size_t first;
+        size_t last;
+    };
+
+    /**
+     * Draws two random cut points; the genes between them, both included, are swapped.
+     */
+
+    static void draw(Plan& plan, size_t size, std::mt19937& engine) {
+        std::uniform_int_distribution<size_t> gap(0, size - 1);
+        plan.first = gap(engine);
+        plan.last = gap(engine);
+
+        if (plan.first > plan.last)
+            std::swap(plan.first, plan.last);
+    }
+
+    static bool swaps(const Plan& plan, size_t gene) { return (gene >= plan.first) && (gene <= plan.last); }
+
+    static void apply(std::vector<int>& first, std::vector<int>& second, std::mt19937& engine) {
+        Plan plan;
+        draw(plan, first.size(), engine);
+        std::swap_ranges(first.begin() + plan.first, first.begin() + plan.last + 1, second.begin() + plan.first);
+    }
+};
+
+struct UniformCrossover {
+    struct Plan {
+        std::vector<uint32_t> bits;
+    };
+
+    /**
+     * Swaps every gene with probability 1/2: draws one random bit per gene, 32 per engine call.
+     */
+
+    static void draw(Plan& plan, size_t size, std::mt19937& engine) {
+        plan.bits.resize((size + 31) / 32);
+        for (auto& word: plan.bits)
+            word = engine();
+    }
+
+    static bool swaps(const Plan& plan, size_t gene) { return (plan.bits[gene / 32] >> (gene % 32)) & 1; }
+
+    static void apply(std::vector<int>& first, std::vector<int>& second, std::mt19937& engine) {
+        Plan plan;
+        draw(plan, first.size(), engine);
+
+        for (size_t i = 0; i < first.size(); ++i)
+            if (swaps(plan, i))
+                std::swap(first[i], second[i]);
+    }
+};
+
+template <class Backend>
+struct DominationRepair {
+    /**
+     * Relabels 2, in increasing vertex order, every 0 without an in-neighbor labeled 3 and every 1
+     * without an in-neighbor labeled 2 or 3. Unlabeled genes (-1) are left alone.
+     *
+     * @return size_t The weight of the repaired labeling, with the vertex costs of the backend.
+     */
+
+    static size_t apply(const Backend& graph, std::vector<int>& genes) {
+        size_t weight = 0;
+
+        for (size_t i = 0; i < genes.size(); ++i) {
+            int label = genes[i];
+
+            if ((label == 0) || (label == 1)) {
+                int needed = label == 0 ? 3 : 2;
+                bool dominated = false;
+
+                for (const auto& neighbor: graph.getInNeighbors(i)) {
+                    if (genes[neighbor] >= needed) {
+                        dominated = true;
+                        break;
+                    }
+                }
+
+                if (!dominated)
+                    genes[i] = label = 2;
+            }
+
+            weight += label > 0 ? label * graph.getCost(i) : 0;
+        }
+
+        return weight;
+    }
+
+    /**
+     * The same repair on many labelings at once, stored vertex-major: the labels of vertex i in the
+     * `rows` labelings are `labels[i * rows]` to `labels[i * rows + rows - 1]`. Vertices are still
+     * repaired in increasing order, so every labeling ends as apply() would leave it, but each
+     * in-neighbor list is read once for all labelings and the comparisons run over contiguous
+     * bytes, which the compiler vectorizes.
+     *
+     * @param weights Receives the weight of every repaired labeling.
+     * @param scratch Reused buffer of 2 * rows bytes.
+     */
+
+    static void applyColumns(const Backend& graph, int8_t* labels, size_t order, size_t rows, size_t* weights,
+                             std::vector<int8_t>& scratch) {
+        scratch.resize(2 * rows);
+        int8_t* __restrict__ needed = scratch.data();
+        int8_t* __restrict__ dominated = scratch.data() + rows;
+
+        // Per-vertex weights are summed in 32 bits, flushed to `weights` before they can overflow.
+        size_t maxCost = 1;
+        for (size_t i = 0; i < order; ++i)
+            maxCost = std::max(maxCost, static_cast<size_t>(graph.getCost(i)));
+
+        size_t flushPeriod = std::numeric_limits<uint32_t>::max() / (3 * maxCost);
+        std::vector<uint32_t> partial(rows, 0);
+        uint32_t* __restrict__ sums = partial.data();
+
+        std::fill(weights, weights + rows, 0);
+
+        for (size_t i = 0; i < order; ++i) {
+            int8_t* __restrict__ own = labels + i * rows;
+            int8_t pending = 0;
+
+            for (size_t r = 0; r < rows; ++r) {
+                int8_t label = own[r];
+                int8_t low = (label == 0) | (label == 1);
+                needed[r] = low ? 3 - label : 4;
+                pending |= low;
+            }
+
+            if (pending) {
+                std::fill(dominated, dominated + rows, 0);
+
+                for (const auto& neighbor: graph.getInNeighbors(i)) {
+                    const int8_t* __restrict__ other = labels + neighbor * rows;
+                    for (size_t r = 0; r < rows; ++r)
+                        dominated[r] |= other[r] >= needed[r];
+                }
+
+                for (size_t r = 0; r < rows; ++r)
+                    own[r] = (needed[r] < 4) & (dominated[r] == 0) ? 2 : own[r];
+            }
+
+            if (flushPeriod == 0) {
+                for (size_t r = 0; r < rows; ++r)
+                    weights[r] += own[r] > 0 ? own[r] * graph.getCost(i) : 0;
+                continue;
+            }
+
+            uint32_t cost = static_cast<uint32_t>(graph.getCost(i));
+            for (size_t r = 0; r < rows; ++r)
+                sums[r] += static_cast<uint32_t>(std::max<int8_t>(own[r], 0)) * cost;
+
+            if (((i + 1) % flushPeriod == 0) || (i + 1 == order)) {
+                for (size_t r = 0; r < rows; ++r)
+                    weights[r] += sums[r];
+                std::fill(partial.begin(), partial.end(), 0);
+            }
+        }
+    }
+
+    /**
+     * Checks every double Roman domination constraint: a 0 needs an in-neighbor labeled 3 or two
+     * labeled 2, a 1 needs one labeled 2 or 3, and an unlabeled vertex is never dominated.
+     */
+
+    static bool isFeasible(const Backend& graph, const std::vector<int>& genes) {
+        for (size_t i = 0; i < genes.size(); ++i) {
+            int label = genes[i];
+
+            if (label >= 2)
+                continue;
+            if (label < 0)
+                return false;
+
+            size_t labeled2 = 0;
+            bool dominated = false;
+
+            for (const auto& neighbor: graph.getInNeighbors(i)) {
+                int neighborLabel = genes[neighbor];
+                labeled2 += neighborLabel == 2 ? 1 : 0;
+
+                if ((neighborLabel == 3) || ((label == 1) && (neighborLabel == 2)) || (labeled2 == 2)) {
+                    dominated = true;
+                    break;
+                }
+            }
+
+            if (!dominated)
+                return false;
+        }
+
+        return true;
+    }
+};
+
+struct Heuristic1 {
+    static Chromosome create(const Graph& graph);
+};
+
+struct Heuristic2 {
+    static Chromosome create(const Graph& graph);
+};
+
+struct Heuristic3 {
+    static Chromosome create(const Graph& graph);
+};
+
+#endif
@@ -4,36 +4,68 @@
 #include <iostream>
 #include <random>
 #include <algorithm>
-#include <list>
-#include <unordered_map>
+#include <vector>
 #include <queue>
 #include <sstream>
 #include <fstream>
 
+/**
+ * Adjacency lists stored as vectors indexed by vertex. Every list entry keeps the position of its
+ * mirror entry (the same edge in the other endpoint's list, or in the in-list of the head of an
+ * arc), so an edge is unlinked in O(1) by moving the last entry of the list into its slot, and a
+ * vertex is deleted in O(deg). Deleted vertices keep their ids, with empty lists.
+ *
+ * On a directed graph an arc (u, v) means that u dominates v: getAdjacencyList(u) holds the
+ * out-neighbors of u, whose counters a label on u feeds, and getInNeighbors(v) the vertices whose
+ * labels dominate v. On an undirected graph both are the same list.
+ *
+ * Every vertex has a positive integer cost, 1 unless the graph file or setCost says otherwise; a
+ * label l on v weighs l * cost(v), so with unit costs the weight is the usual sum of labels.
+ */
+
 class Graph {
 private:
     size_t order;
     size_t size;
     bool isDirected;  
-    std::unordered_map<size_t, std::list<size_t>> adjList;
-    void addEdge(size_t source, size_t destination);
-    Graph readGraph(const std::string& filename);
+    std::vector<bool> alive;
+    std::vector<std::vector<size_t>> outNeighbors;
+    std::vector<std::vector<size_t>> outPositions;
+    std::vector<std::vector<size_t>> inNeighbors;
+    std::vector<std::vector<size_t>> inPositions;
+    std::vector<size_t> costs;
+
+    void unlink(std::vector<std::vector<size_t>>& neighbors, std::vector<std::vector<size_t>>& positions,
+                std::vector<std::vector<size_t>>& mirrorPositions, size_t vertex, size_t position);
 public:	
 
     Graph(size_t order, bool isDirected, float probabilityOfEdge);	
     Graph(const std::string& filename, bool isDirected);
     Graph(size_t order, bool isDirected);	
     Graph(const Graph& graph);
+    Graph& operator=(const Graph& graph) = default;
     Graph();
     ~Graph() = default;
  
+    bool addEdge(size_t source, size_t destination);
+    bool removeEdge(size_t source, size_t destination);
+
     size_t getSize() const;
     size_t getOrder() const;
     size_t getVertexDegree(size_t vertex) const;
+    size_t getInDegree(size_t vertex) const;
+    bool isDirectedGraph() const;
+
+    size_t getCost(size_t vertex) const { return this->costs[vertex]; }
+    void setCost(size_t vertex, size_t cost);
+    bool isWeightedGraph() const;
+    size_t getWeight(const std::vector<int>& labels) const;
+    
+    std::vector<size_t> getVertices() const;
     
-    std::unordered_map<size_t, std::list<size_t>> getAdjacencyList() const;
+    const std::vector<size_t>& getAdjacencyList(size_t vertex) const;
     
-    const std::list<size_t>& getAdjacencyList(size_t vertex) const;
+    const std::vector<size_t>& getInNeighbors(size_t vertex) const;
     
     bool edgeExists(size_t u, size_t v) const;
     
@@ -0,0 +1,47 @@
+#ifndef GRAPH_REDUCTION_HPP
+#define GRAPH_REDUCTION_HPP
+
+#include "Graph.hpp"
+#include <functional>
+#include <vector>
+
+struct ReductionStatistics {
+    size_t isolatedVertices;
+    size_t removedLeaves;
+    size_t removedTwins;
+    size_t components;
+    size_t componentsSolvedExactly;
+    size_t reducedOrder;
+};
+
+class GraphReduction {
+    private:
+        struct TwinClass {
+            std::vector<size_t> neighbors;
+            std::vector<size_t> kept;
+            std::vector<size_t> removed;
+        };
+
+        size_t originalOrder;
+        std::vector<int> fixedLabels;
+        std::vector<TwinClass> twinClasses;
+        std::vector<std::vector<size_t>> componentVertices;
+        std::vector<Graph> componentGraphs;
+        ReductionStatistics statistics;
+
+    public:
+        static const size_t maxLeavesPerSupport = 2;
+        static const size_t maxTwinsPerClass = 5;
+
+        explicit GraphReduction(const Graph& graph);
+
+        size_t getNumberOfComponents() const;
+        Graph& getComponent(size_t component);
+        const std::vector<size_t>& getComponentVertices(size_t component) const;
+        const ReductionStatistics& getStatistics() const;
+
+        std::vector<int> lift(const std::vector<std::vector<int>>& componentSolutions) const;
+        std::vector<int> solve(const std::function<std::vector<int>(Graph&)>& solver, size_t numberOfThreads = 1);
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef LOCAL_SEARCH_HPP
+#define LOCAL_SEARCH_HPP
+
+#include "Graph.hpp"
+#include "DominationState.hpp"
+#include <limits>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+/**
+ * Moves of the local search, each anchored at one vertex v:
+ *  - Lower: v takes the least label that keeps its closed neighborhood dominated (3 -> 2, or a 2
+ *    or 1 whose dependents are covered by others dropped to 0);
+ *  - Swap: v, labeled 3, hands its 3 to the neighbor `partner` and drops to `label`;
+ *  - Merge: v is raised to 3 and one or two neighbors labeled 2 (`partner`, `second`) drop to 0,
+ *    i.e. two 2s become one 3.
+ * The gain is the weight the move saves, in cost units.
+ */
+
+enum class MoveType { Lower, Swap, Merge };
+
+struct LocalSearchMove {
+    MoveType type;
+    size_t vertex;
+    size_t partner;
+    size_t second;
+    int label;
+    long long gain;
+};
+
+struct LocalSearchStatistics {
+    size_t calls;
+    size_t lowered;
+    size_t swapped;
+    size_t merged;
+    size_t sweeps;
+
+    LocalSearchStatistics(): calls(0), lowered(0), swapped(0), merged(0), sweeps(0) {}
+};
+
+class LocalSearch {
+    private:
+        static const size_t none = std::numeric_limits<size_t>::max();
+
+        const Graph& graph;
+        std::vector<LocalSearchMove> gains;
+        std::vector<size_t> versions;
+        std::priority_queue<std::tuple<long long, size_t, size_t>> queue;
+        std::vector<size_t> candidates;
+        LocalSearchStatistics statistics;
+
+        int lowestLabel(const DominationState& state, size_t vertex) const;
+        LocalSearchMove evaluate(DominationState& state, size_t vertex);
+        void refresh(DominationState& state, size_t vertex);
+        void record(size_t vertex, const LocalSearchMove& move);
+        void refreshAround(DominationState& state, size_t vertex);
+        void apply(DominationState& state, const LocalSearchMove& move);
+
+    public:
+        explicit LocalSearch(const Graph& graph);
+
+        size_t improve(std::vector<int>& solution, size_t maxMoves = 0);
+
+        const LocalSearchStatistics& getStatistics() const;
+};
+
+#endif
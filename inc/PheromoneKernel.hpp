@@ -0,0 +1,74 @@
+#ifndef PHEROMONE_KERNEL_HPP
+#define PHEROMONE_KERNEL_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+template <typename T, size_t Alignment>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t n) {
+        size_t bytes = ((n * sizeof(T) + Alignment - 1) / Alignment) * Alignment;
+        void* pointer = std::aligned_alloc(Alignment, bytes == 0 ? Alignment : bytes);
+        if (!pointer)
+            throw std::bad_alloc();
+        return static_cast<T*>(pointer);
+    }
+
+    void deallocate(T* pointer, size_t) { std::free(pointer); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+using PheromoneVector = std::vector<float, AlignedAllocator<float, 32>>;
+
+struct PheromoneSummary {
+    float minPheromone;
+    float maxPheromone;
+    float convergenceFactor;
+};
+
+class PheromoneKernel {
+    private:
+        using UpdateFunction = PheromoneSummary(*)(float*, const int*, const int*, size_t,
+                float, float, float, float, float);
+
+        static UpdateFunction select();
+
+        static PheromoneSummary updateScalar(float* pheromone, const int* currentBestSolution,
+                const int* bestSolution, size_t size, float currentBestShare, float bestShare,
+                float evaporationRate, float minBound, float maxBound);
+
+        static PheromoneSummary updateAVX2(float* pheromone, const int* currentBestSolution,
+                const int* bestSolution, size_t size, float currentBestShare, float bestShare,
+                float evaporationRate, float minBound, float maxBound);
+
+    public:
+        static bool hasAVX2();
+        static const char* getImplementationName();
+
+        static PheromoneSummary update(float* pheromone, const int* currentBestSolution,
+                const int* bestSolution, size_t size, float currentBestShare, float bestShare,
+                float evaporationRate, float minBound, float maxBound);
+
+        static PheromoneSummary updateReference(float* pheromone, const int* currentBestSolution,
+                const int* bestSolution, size_t size, float currentBestShare, float bestShare,
+                float evaporationRate, float minBound, float maxBound);
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef DRD_PROFILE
+
+#define PROFILE_SCOPE(name) \
+    static const size_t PROFILE_CONCAT(profileEvent, __LINE__) = Profiler::registerEvent(name); \
+    ScopedTimer PROFILE_CONCAT(profileScope, __LINE__)(PROFILE_CONCAT(profileEvent, __LINE__))
+
+#define PROFILE_COUNT(name) \
+    do { \
+        static const size_t profileCounter = Profiler::registerEvent(name); \
+        Profiler::count(profileCounter); \
+    } while (0)
+
+#else
+
+#define PROFILE_SCOPE(name) do {} while (0)
+#define PROFILE_COUNT(name) do {} while (0)
+
+#endif
+
+struct ProfileEntry {
+    uint64_t calls;
+    uint64_t totalNanoseconds;
+    uint64_t minNanoseconds;
+    uint64_t maxNanoseconds;
+};
+
+struct TraceEvent {
+    size_t event;
+    uint64_t startNanoseconds;
+    uint64_t durationNanoseconds;
+};
+
+class Profiler {
+    public:
+        static size_t registerEvent(const char* name);
+        static void count(size_t event);
+        static void record(size_t event, uint64_t startNanoseconds, uint64_t durationNanoseconds);
+        static uint64_t now();
+
+        static void writeSummary(std::ostream& os);
+        static void writeChromeTrace(const std::string& filename);
+};
+
+class ScopedTimer {
+    private:
+        size_t event;
+        uint64_t start;
+
+    public:
+        explicit ScopedTimer(size_t event) : event(event), start(Profiler::now()) {}
+        ~ScopedTimer() { Profiler::record(event, start, Profiler::now() - start); }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <random>
+
+class Random {
+    public:
+        static std::mt19937& engine();
+        static void seed(unsigned int value);
+        static unsigned int seedFromEnvironment();
+};
+
+#endif
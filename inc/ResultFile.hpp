@@ -0,0 +1,121 @@
+#ifndef RESULT_FILE_HPP
+#define RESULT_FILE_HPP
+
+#include "Graph.hpp"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Result files hold the solutions of one run on one graph: γ2R, the labeling, the time and a
+ * certificate per engine, plus the graph, seed and lower bound of the run. They are written as
+ * JSON (paths ending in ".json") or in a compact binary format (any other path).
+ */
+
+enum class ResultFormat { Json, Binary };
+
+/**
+ * The certificate lists the dominators of every vertex labeled 0 or 1, in increasing vertex
+ * order, as { vertex, witness, second witness }: one neighbor labeled 3 or two labeled 2 for a 0,
+ * one neighbor labeled 2 or 3 for a 1. Witnesses that could not be found are `none`.
+ */
+
+struct EngineResult {
+    static const size_t none = std::numeric_limits<size_t>::max();
+
+    std::string engine;
+    size_t gamma2r;
+    double milliseconds;
+    std::vector<int> labels;
+    std::vector<std::array<size_t, 3>> certificate;
+
+    EngineResult(): gamma2r(0), milliseconds(0.0) {}
+};
+
+struct ResultFile {
+    std::string graphPath;
+    size_t order;
+    size_t size;
+    bool directed;
+    bool weighted;
+    size_t lowerBound;
+    uint64_t seed;
+    std::vector<EngineResult> engines;
+
+    ResultFile(): order(0), size(0), directed(false), weighted(false), lowerBound(0), seed(0) {}
+};
+
+/**
+ * Buffered writes to a C stream: text and raw bytes go to a fixed buffer that reaches the stream
+ * in one fwrite when full, instead of one formatted iostream call per element.
+ */
+
+class OutputBuffer {
+    private:
+        std::FILE* file;
+        std::vector<char> bytes;
+        size_t used;
+        bool failed;
+
+    public:
+        explicit OutputBuffer(std::FILE* file, size_t capacity = 1 << 16);
+        ~OutputBuffer();
+
+        OutputBuffer(const OutputBuffer&) = delete;
+        OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+        void put(char character) {
+            if (this->used == this->bytes.size())
+                this->flush();
+            this->bytes[this->used++] = character;
+        }
+
+        void write(const char* data, size_t length);
+        void write(const std::string& text);
+        void writeInteger(long long value);
+        void writeDecimal(double value);
+
+        template <typename T>
+        void writeBytes(const T& value) {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values are written as bytes");
+            this->write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        bool flush();
+};
+
+class ResultWriter {
+    private:
+        const Graph& graph;
+        ResultFile result;
+
+        void writeJson(OutputBuffer& output) const;
+        void writeBinary(OutputBuffer& output) const;
+
+    public:
+        ResultWriter(const Graph& graph, const std::string& graphPath, uint64_t seed, size_t lowerBound);
+
+        void add(const std::string& engine, const std::vector<int>& labels, double milliseconds);
+        void write(const std::string& path) const;
+
+        const ResultFile& getResult() const;
+
+        static std::vector<std::array<size_t, 3>> certify(const Graph& graph, const std::vector<int>& labels);
+        static ResultFormat formatOf(const std::string& path);
+        static void printLabels(const std::vector<int>& labels, std::FILE* file = stdout);
+};
+
+class ResultReader {
+    private:
+        static ResultFile readJson(const std::string& path, const std::string& text);
+        static ResultFile readBinary(const std::string& path, const std::vector<char>& bytes);
+
+    public:
+        static ResultFile read(const std::string& path);
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef SHARED_INCUMBENT_HPP
+#define SHARED_INCUMBENT_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+enum class IncumbentSource { GeneticAlgorithm, ACO };
+
+struct IncumbentSolution {
+    std::vector<int> solution;
+    size_t weight;
+    IncumbentSource source;
+};
+
+class SharedIncumbent {
+    private:
+        std::shared_ptr<const IncumbentSolution> slot;
+        std::atomic<size_t> weight;
+
+    public:
+        SharedIncumbent(): weight(std::numeric_limits<size_t>::max()) {}
+
+        SharedIncumbent(const SharedIncumbent&) = delete;
+        SharedIncumbent& operator=(const SharedIncumbent&) = delete;
+
+        bool offer(const std::vector<int>& solution, size_t weight, IncumbentSource source);
+        std::shared_ptr<const IncumbentSolution> load() const;
+        size_t getWeight() const;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef TABU_SEARCH_HPP
+#define TABU_SEARCH_HPP
+
+#include "Graph.hpp"
+#include "DominationState.hpp"
+#include <array>
+#include <limits>
+#include <vector>
+
+/**
+ * Tabu search over labelings that may leave vertices undominated. A move relabels one vertex and
+ * is scored by its weight change plus `penalty` times its change in undominated vertices, so the
+ * search can cross infeasible labelings; the penalty rises while the search stays infeasible and
+ * falls while it stays feasible (strategic oscillation).
+ */
+
+struct TabuSettings {
+    size_t iterations;
+    size_t stallIterations;
+    size_t tenure;
+    size_t tenureRange;
+    size_t penaltyPeriod;
+    double timeBudget;
+
+    TabuSettings(): iterations(10000), stallIterations(2000), tenure(7), tenureRange(10), penaltyPeriod(20),
+                    timeBudget(0.0) {}
+};
+
+struct TabuStatistics {
+    size_t iterations;
+    size_t improvements;
+    size_t aspirations;
+    size_t infeasibleIterations;
+
+    TabuStatistics(): iterations(0), improvements(0), aspirations(0), infeasibleIterations(0) {}
+};
+
+class TabuSearch {
+    private:
+        static const size_t none = std::numeric_limits<size_t>::max();
+
+        const Graph& graph;
+        TabuSettings settings;
+        size_t lowerBound;
+        std::vector<int> bestSolution;
+        size_t bestWeight;
+        std::vector<std::array<int, 4>> deltas;
+        std::vector<size_t> tabuUntil;
+        TabuStatistics statistics;
+
+        void evaluate(const DominationState& state, size_t vertex);
+        void adjustAround(const DominationState& state, size_t vertex, int sign);
+
+    public:
+        TabuSearch(const Graph& graph, const TabuSettings& settings = TabuSettings());
+
+        size_t run(const std::vector<int>& initialSolution);
+
+        void setLowerBound(size_t lowerBound);
+        const std::vector<int>& getBestSolution() const;
+        size_t getBestWeight() const;
+        const TabuStatistics& getStatistics() const;
+};
+
+#endif
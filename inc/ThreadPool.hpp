@@ -0,0 +1,57 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include "Topology.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+    private:
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::vector<std::thread> workers;
+        std::vector<size_t> workerNodes;
+        std::vector<std::vector<size_t>> victims;
+        AffinityPolicy affinity;
+        std::mutex mutex;
+        std::condition_variable taskAvailable;
+        std::condition_variable allDone;
+        std::atomic<size_t> pendingTasks;
+        size_t queuedTasks;
+        std::atomic<size_t> nextQueue;
+        std::atomic<size_t> steals;
+        bool stopping;
+
+        void placeWorkers();
+        void workerLoop(size_t index);
+        bool popTask(size_t index, std::function<void()>& task);
+        bool stealTask(size_t index, std::function<void()>& task);
+
+    public:
+        explicit ThreadPool(size_t numberOfThreads = 0, AffinityPolicy affinity = AffinityPolicy::None);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void submit(std::function<void()> task);
+        void wait();
+
+        size_t getNumberOfThreads() const;
+        size_t getNumberOfSteals() const;
+        size_t getWorkerNode(size_t worker) const;
+
+        static size_t getCurrentWorker();
+};
+
+#endif
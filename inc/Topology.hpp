@@ -0,0 +1,78 @@
+#ifndef TOPOLOGY_HPP
+#define TOPOLOGY_HPP
+
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Where the threads of a pool run: anywhere (None), on the CPUs of one NUMA node (Node, so a
+ * thread and the memory it first touched stay on the same socket) or on one CPU (Core).
+ */
+
+enum class AffinityPolicy { None, Node, Core };
+
+class Topology {
+    private:
+        std::vector<std::vector<size_t>> nodeCpus;
+        std::vector<size_t> cpuNodes;
+
+        Topology();
+
+        static std::vector<size_t> parseCpuList(const std::string& list);
+
+    public:
+        static const size_t none = std::numeric_limits<size_t>::max();
+
+        static const Topology& get();
+
+        size_t getNumberOfNodes() const;
+        size_t getNumberOfCpus() const;
+        const std::vector<size_t>& getCpus(size_t node) const;
+        size_t getNode(size_t cpu) const;
+
+        static size_t getCurrentNode();
+        static size_t getBoundNode();
+        static bool bindToNode(size_t node);
+        static bool bindToCpu(size_t cpu);
+
+        static AffinityPolicy parse(const std::string& name);
+};
+
+/**
+ * Read-only data replicated per NUMA node. Each replica is copied by the first thread of its node
+ * that asks for it, so its pages are first touched, hence allocated, on that node; the node that
+ * holds the original, and every node when replication is off, uses the original.
+ */
+
+template <typename T>
+class NodeReplicas {
+    private:
+        std::shared_ptr<T> original;
+        size_t home;
+        bool replicate;
+        std::vector<std::shared_ptr<T>> replicas;
+        std::mutex mutex;
+
+    public:
+        NodeReplicas(std::shared_ptr<T> original, bool replicate)
+            : original(original), home(Topology::getCurrentNode()),
+              replicate(replicate && (Topology::get().getNumberOfNodes() > 1)),
+              replicas(Topology::get().getNumberOfNodes()) {}
+
+        T& get(size_t node) {
+            if (!this->replicate || (node == this->home) || (node >= this->replicas.size()))
+                return *this->original;
+
+            std::lock_guard<std::mutex> lock(this->mutex);
+            if (!this->replicas[node])
+                this->replicas[node] = std::make_shared<T>(*this->original);
+            return *this->replicas[node];
+        }
+
+        T& local() { return this->get(Topology::getCurrentNode()); }
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef VERTEX_ORDERING_HPP
+#define VERTEX_ORDERING_HPP
+
+#include "Graph.hpp"
+#include <string>
+#include <vector>
+
+enum class OrderingStrategy { Identity, BFS, ReverseCuthillMcKee, DegreeDescending, Community };
+
+class VertexOrdering {
+    private:
+        std::vector<size_t> newToOriginal;
+        std::vector<size_t> originalToNew;
+
+        static std::vector<std::vector<size_t>> adjacencyOf(const Graph& graph);
+        static std::vector<size_t> breadthFirstOrder(const std::vector<std::vector<size_t>>& adjacency, bool byDegree,
+                bool peripheralStart);
+        static std::vector<size_t> degreeOrder(const std::vector<std::vector<size_t>>& adjacency);
+        static std::vector<size_t> communityOrder(const std::vector<std::vector<size_t>>& adjacency);
+
+    public:
+        VertexOrdering(const Graph& graph, OrderingStrategy strategy);
+
+        Graph apply(const Graph& graph) const;
+        std::vector<int> toOriginal(const std::vector<int>& solution) const;
+        std::vector<int> toReordered(const std::vector<int>& solution) const;
+
+        size_t getNewId(size_t originalVertex) const;
+        size_t getOriginalId(size_t newVertex) const;
+
+        static OrderingStrategy parse(const std::string& name);
+        static double averageNeighborDistance(const Graph& graph);
+};
+
+#endif
@@ -1,38 +1,262 @@
 #include "AntColonyOptimization.hpp"
+#include "Random.hpp"
+#include "Profiler.hpp"
+#include "GeneticOperators.hpp"
+#include "Topology.hpp"
+#include <stdexcept>
+
+/**
+ * @brief Runs the ACO until one of the stopping criteria is met.
+ *
+ * Besides the iteration limit, the run stops after `maxNoImprovementIterations` iterations without
+ * improving the best-so-far solution, when the wall-clock budget (in seconds) is exhausted or when
+ * the best-so-far weight reaches `targetWeight`; a zero disables a criterion. Like the cancellation
+ * flag, the budget is polled between ants and between RVNS iterations, so a slow iteration is cut
+ * short at the deadline rather than run to its end. The colony restarts,
+ * according to the restart policy, when the convergence factor exceeds the threshold or when the
+ * restart-best solution stagnates for `restartNoImprovementIterations` iterations. One telemetry
+ * record is kept, and handed to the iteration callback, per iteration. Raising the cancellation
+ * flag stops the run at the next ant. With a shared incumbent, the best-so-far solution is
+ * exchanged with the concurrent algorithm before every pheromone update. An ant reaching the
+ * lower bound, if one is set, ends the run with StopReason::LowerBound, since no lighter solution exists.
+ * With setLocalSearch(true), every ant's solution is taken to a local optimum of LocalSearch after
+ * RVNS, as a daemon action.
+ * With a checkpoint writer, the run is saved every `checkpointInterval` iterations and when it
+ * ends; after resume() it continues from the checkpoint, the time budget included. After
+ * warmStart() it keeps the pheromones of the previous run.
+ */
 
 void AntColonyOptimization::run() {
-    size_t temp = iterations;
-    while (temp > 0) {
-        for (size_t i = 0; i < numberOfAnts; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    size_t firstIteration = 0;
+    double elapsedBefore = 0.0;
+
+    if (resumePoint.pending) {
+        resumePoint.pending = false;
+        Random::engine() = resumePoint.engine;
+        elapsedBefore = resumedElapsedSeconds;
+        if (resumePoint.finished)
+            return;
+        firstIteration = resumePoint.step;
+    } else {
+        noImprovementIterations = 0;
+        restartNoImprovement = 0;
+        if (!warmStarted)
+            initializePheromones(graphPheromone);
+        warmStarted = false;
+        telemetry.clear();
+        numberOfRestarts = 0;
+        stopReason = StopReason::IterationLimit;
+    }
+
+    std::chrono::duration<double> remaining(stopCriteria.timeBudget - elapsedBefore);
+    deadline = std::chrono::steady_clock::time_point::max();
+    if ((stopCriteria.timeBudget > 0.0) && (remaining < std::chrono::steady_clock::time_point::max() - start))
+        deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(remaining);
+
+    auto elapsedSeconds = [&]() {
+        return elapsedBefore + std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    std::unique_ptr<LocalSearch> daemon(localSearchEnabled ? new LocalSearch(graph) : nullptr);
+
+    size_t iteration = firstIteration;
+    for (; iteration < iterations; ++iteration) {
+        PROFILE_SCOPE("ACO::iteration");
+        size_t iterationBestWeight = std::numeric_limits<size_t>::max();
+        size_t restartBestWeight = summation(currentBestSolution);
+        size_t bestWeight = summation(bestSolution);
+
+        for (size_t i = 0; (i < numberOfAnts) && !isCancelled(); ++i) {
+            std::fill(solution.begin(), solution.end(), -1);
             solution = constructSolution(solution);
             solution = extendSolution(solution);
             solution = reduceSolution(solution);
-            solution = RVNS(solution);
-            
-         	if (summation(solution) < summation(currentBestSolution))
+            solution = numberOfRVNSThreads > 1 ? parallelRVNS(solution) : RVNS(solution);
+            if (daemon)
+                daemon->improve(solution);
+            ++evaluations;
+
+            size_t weight = summation(solution);
+            iterationBestWeight = std::min(iterationBestWeight, weight);
+
+         	if (weight < summation(currentBestSolution))
                 currentBestSolution = solution;
+
+            if (weight <= lowerBound)
+                break;
       	}    
+
+        restartNoImprovement = summation(currentBestSolution) < restartBestWeight ? 0 : restartNoImprovement + 1;
                                                            
-        if (summation(currentBestSolution) < summation(bestSolution))
-              bestSolution = currentBestSolution;
+        if (summation(currentBestSolution) < bestWeight) {
+            bestSolution = currentBestSolution;
+            noImprovementIterations = 0;
+        }
+
+        else
+            ++noImprovementIterations;
+
+        if (sharedIncumbent && exchangeIncumbent())
+            noImprovementIterations = 0;
         
         updatePheromones(currentBestSolution, bestSolution, graphPheromone);
                                                                
-        convergenceFactor = computeConvergence(graphPheromone);
+        convergenceFactor = computeConvergence();
+
+        ACOIterationTelemetry record = { iteration, convergenceFactor, iterationBestWeight,
+                summation(currentBestSolution), summation(bestSolution),
+                elapsedSeconds(), false };
                                  
-        if (convergenceFactor > 0.99)
-            initializePheromones(graphPheromone);
-		
-        --temp;
+        if ((restartPolicy != RestartPolicy::None) &&
+            ((convergenceFactor > restartConvergenceThreshold) ||
+             ((restartNoImprovementIterations > 0) && (restartNoImprovement >= restartNoImprovementIterations)))) {
+            restart();
+            restartNoImprovement = 0;
+            record.restarted = true;
+        }
+
+        telemetry.push_back(record);
+
+        if (iterationCallback)
+            iterationCallback(record);
+
+        if (cancellationFlag && cancellationFlag->load(std::memory_order_relaxed)) {
+            stopReason = StopReason::Cancelled;
+            break;
+        }
+
+        if (record.bestWeight <= lowerBound) {
+            stopReason = StopReason::LowerBound;
+            break;
+        }
+
+        if ((stopCriteria.targetWeight > 0) && (record.bestWeight <= stopCriteria.targetWeight)) {
+            stopReason = StopReason::TargetWeight;
+            break;
+        }
+
+        if ((stopCriteria.maxNoImprovementIterations > 0) &&
+            (noImprovementIterations >= stopCriteria.maxNoImprovementIterations)) {
+            stopReason = StopReason::NoImprovement;
+            break;
+        }
+
+        if ((stopCriteria.timeBudget > 0.0) && (record.elapsedSeconds >= stopCriteria.timeBudget)) {
+            stopReason = StopReason::TimeBudget;
+            break;
+        }
+
+        if (checkpointWriter && (checkpointInterval > 0) && ((iteration + 1) % checkpointInterval == 0) &&
+            (iteration + 1 < iterations))
+            saveCheckpoint(iteration + 1, record.elapsedSeconds, false);
     }    
+
+    if (checkpointWriter)
+        saveCheckpoint(std::min(iteration + 1, iterations), elapsedSeconds(), stopReason != StopReason::Cancelled);
+}
+
+/**
+ * @brief Snapshots to `path` every `interval` iterations and when the run ends, through a writer
+ * owned by the caller that saves them in the background; a null writer disables it.
+ */
+
+void AntColonyOptimization::setCheckpoint(CheckpointWriter* checkpointWriter, const std::string& path, size_t interval) {
+    this->checkpointWriter = checkpointWriter;
+    this->checkpointPath = path;
+    this->checkpointInterval = interval;
+}
+
+/**
+ * @brief Loads a checkpoint written by a run with the same graph and parameters; the next run()
+ * continues it with the saved pheromones, best solutions, counters, telemetry and random engine,
+ * so it makes the same choices as the interrupted run. A checkpoint of a finished run only
+ * restores its results. With several RVNS threads the workers are seeded from the restored
+ * engine, so the portfolio replays as well; runs sharing an incumbent do not.
+ *
+ * @throws std::runtime_error if the file is not an ACO checkpoint of this graph.
+ */
+
+void AntColonyOptimization::resume(const std::string& path) {
+    CheckpointReader reader(path, CheckpointKind::ACO, this->graph);
+
+    resumePoint.step = reader.read<uint64_t>();
+    resumePoint.finished = reader.read<bool>();
+    reader.readEngine(resumePoint.engine);
+    resumedElapsedSeconds = reader.read<double>();
+    stopReason = reader.read<StopReason>();
+    noImprovementIterations = reader.read<uint64_t>();
+    restartNoImprovement = reader.read<uint64_t>();
+    numberOfRestarts = reader.read<uint64_t>();
+    evaluations = reader.read<uint64_t>();
+    convergenceFactor = reader.read<float>();
+    pheromoneSummary = reader.read<PheromoneSummary>();
+    statisticsRVNS = reader.read<RVNSStatistics>();
+    reader.readVector(graphPheromone);
+    reader.readVector(currentBestSolution);
+    reader.readVector(bestSolution);
+    reader.readVector(telemetry);
+
+    if ((graphPheromone.size() != graph.getOrder()) || (bestSolution.size() != graph.getOrder()))
+        throw std::runtime_error(path + " was written for another graph");
+
+    resumePoint.pending = true;
+}
+
+/**
+ * @brief Serializes the colony and the random engine of the calling thread, and hands the bytes
+ * to the checkpoint writer.
+ *
+ * @param iteration The next iteration to run.
+ * @param elapsedSeconds Time spent by the run so far, resumed runs included.
+ * @param finished Whether the run has ended.
+ */
+
+void AntColonyOptimization::saveCheckpoint(size_t iteration, double elapsedSeconds, bool finished) {
+    PROFILE_SCOPE("ACO::saveCheckpoint");
+    CheckpointBuffer buffer(CheckpointKind::ACO, graph);
+
+    buffer.write<uint64_t>(iteration);
+    buffer.write(finished);
+    buffer.writeEngine(Random::engine());
+    buffer.write(elapsedSeconds);
+    buffer.write(stopReason);
+    buffer.write<uint64_t>(noImprovementIterations);
+    buffer.write<uint64_t>(restartNoImprovement);
+    buffer.write<uint64_t>(numberOfRestarts);
+    buffer.write<uint64_t>(evaluations);
+    buffer.write(convergenceFactor);
+    buffer.write(pheromoneSummary);
+    buffer.write(statisticsRVNS);
+    buffer.writeVector(graphPheromone);
+    buffer.writeVector(currentBestSolution);
+    buffer.writeVector(bestSolution);
+    buffer.writeVector(telemetry);
+
+    checkpointWriter->submit(checkpointPath, std::move(buffer.getBytes()));
+}
+
+/**
+ * @brief Restarts the colony: resets the pheromones and, depending on the policy, the
+ * restart-best solution. The best-so-far solution is always kept.
+ */
+
+void AntColonyOptimization::restart() {
+    initializePheromones(graphPheromone);
+
+    if (restartPolicy == RestartPolicy::ResetPheromonesAndRestartBest)
+        std::fill(currentBestSolution.begin(), currentBestSolution.end(), 3);
+
+    ++numberOfRestarts;
 }
 
-void AntColonyOptimization::initializePheromones(std::vector<float>& graphPheromone) {
-    for (size_t i = 0; i < graphPheromone.size(); ++i)
-        graphPheromone[i] = 0.5;
+void AntColonyOptimization::initializePheromones(PheromoneVector& graphPheromone) {
+    std::fill(graphPheromone.begin(), graphPheromone.end(), 0.5f);
+    pheromoneSummary = { 0.5f, 0.5f, 0.0f };
 }
 
 std::vector<int> AntColonyOptimization::constructSolution(std::vector<int> solution) {
+    PROFILE_SCOPE("ACO::constructSolution");
     Graph temp(this->graph);
     size_t vertex = 0;
 
@@ -51,7 +275,7 @@ std::vector<int> AntColonyOptimization::constructSolution(std::vector<int> solut
 }
 
 std::vector<int> AntColonyOptimization::extendSolution(std::vector<int> solution) {
-    constexpr float addVerticesRate = 0.05f;
+    PROFILE_SCOPE("ACO::extendSolution");
     size_t itr = 0;
 
     std::vector<int> twoOrZeroLabeledVertices;
@@ -60,13 +284,13 @@ std::vector<int> AntColonyOptimization::extendSolution(std::vector<int> solution
             twoOrZeroLabeledVertices.push_back(i);
     }
 
-    itr = addVerticesRate * twoOrZeroLabeledVertices.size();
+    itr = this->parameters.addVerticesRate * twoOrZeroLabeledVertices.size();
     
     size_t vertex = 0;
 
     while (itr != 0 && !twoOrZeroLabeledVertices.empty()) {          
         vertex = chooseVertex(twoOrZeroLabeledVertices);         
-        solution[vertex] = 3; 
+        solution[twoOrZeroLabeledVertices[vertex]] = 3; 
         twoOrZeroLabeledVertices.erase(twoOrZeroLabeledVertices.begin() + vertex);                                                                
         --itr;
     }
@@ -75,6 +299,7 @@ std::vector<int> AntColonyOptimization::extendSolution(std::vector<int> solution
 }
 
 std::vector<int> AntColonyOptimization::reduceSolution(std::vector<int> solution) {
+    PROFILE_SCOPE("ACO::reduceSolution");
     Graph temp = this->graph;
     std::vector<int> sortedVertices;
     int initLabel = -1;
@@ -83,9 +308,7 @@ std::vector<int> AntColonyOptimization::reduceSolution(std::vector<int> solution
         sortedVertices.push_back(i);
 
     std::sort(sortedVertices.begin(), sortedVertices.end(),
-        [&](size_t a, size_t b) {
-            return temp.getVertexDegree(a) < temp.getVertexDegree(b);                                                                             
-        });
+        [&](size_t a, size_t b) { return reducedBefore(a, b); });
     
     size_t choosenVertex = 0;
     
@@ -119,61 +342,353 @@ std::vector<int> AntColonyOptimization::reduceSolution(std::vector<int> solution
 
 
 
-std::vector<int> AntColonyOptimization::destroySolution(std::vector<int> solution) {
-    float destructionRate = minDestructionRate + ((currentRVNSnumber - 1) *
-                ((maxDestructionRate - minDestructionRate)) 
-                / (maxRVNSfunctions - 1));
-    Graph temp = this->graph;
-    size_t itr = solution.size() * destructionRate; 
-    size_t vertex = 0;
-    while (itr != 0 && (temp.getOrder() > 0)) {
-       vertex = chooseVertex(temp);
-       if ((solution[vertex] == 0) || (solution[vertex] == 2))
-            solution[vertex] = -1;
-       else
-            ++itr;
-       temp.deleteVertex(vertex);
-       --itr;
+/**
+ * @brief Unlabels a random share of the vertices labeled 0 or 2.
+ *
+ * The share grows linearly from `minDestructionRate` to `maxDestructionRate` of the parameters
+ * with the RVNS neighborhood. Every change is recorded in `changes`, so it can be undone.
+ *
+ * @param state The domination state of the solution being perturbed.
+ * @param neighborhood The RVNS neighborhood, from 1 to `maxRVNSfunctions`.
+ * @param changes Undo log receiving the (vertex, previous label) pairs.
+ * @return The vertices that were unlabeled.
+ */
+
+std::vector<size_t> AntColonyOptimization::destroySolution(DominationState& state, size_t neighborhood,
+                                                           std::vector<std::pair<size_t, int>>& changes) {
+    PROFILE_SCOPE("ACO::destroySolution");
+    const ACOParameters& parameters = this->parameters;
+    float destructionRate = parameters.maxRVNSfunctions < 2 ? parameters.minDestructionRate
+                          : parameters.minDestructionRate + ((neighborhood - 1) *
+                            ((parameters.maxDestructionRate - parameters.minDestructionRate))
+                            / (parameters.maxRVNSfunctions - 1));
+
+    std::mt19937& seed = Random::engine();
+
+    std::vector<size_t> twoOrZeroLabeledVertices;
+    for (size_t i = 0; i < state.getLabels().size(); ++i)
+        if ((state.getLabel(i) == 0) || (state.getLabel(i) == 2))
+            twoOrZeroLabeledVertices.push_back(i);
+
+    size_t itr = std::min(static_cast<size_t>(state.getLabels().size() * destructionRate),
+                          twoOrZeroLabeledVertices.size());
+
+    for (size_t i = 0; i < itr; ++i) {
+        std::uniform_int_distribution<size_t> gap(i, twoOrZeroLabeledVertices.size() - 1);
+        std::swap(twoOrZeroLabeledVertices[i], twoOrZeroLabeledVertices[gap(seed)]);
+        relabel(state, twoOrZeroLabeledVertices[i], -1, changes);
     }
 
-    return solution;
+    twoOrZeroLabeledVertices.resize(itr);
+
+    return twoOrZeroLabeledVertices;
 } 
 
+/**
+ * @brief Relabels a vertex and records its previous label in the undo log.
+ */
+
+void AntColonyOptimization::relabel(DominationState& state, size_t vertex, int label,
+                                    std::vector<std::pair<size_t, int>>& changes) {
+    changes.push_back({vertex, state.getLabel(vertex)});
+    state.setLabel(vertex, label);
+}
+
+/**
+ * @brief Repairs a destroyed solution by touching only the destroyed region.
+ *
+ * The region is formed by the destroyed vertices and their neighbors, the only vertices whose
+ * domination may have been lost. The residual graph (the undominated vertices of the region) is
+ * covered as in ConstructSolution, a few vertices of the region are raised to 3 as in
+ * ExtendSolution, and ReduceSolution is applied to the region and to the neighbors of the vertices
+ * raised to 3, using the domination counters instead of a full feasibility check.
+ *
+ * @param state The domination state of the destroyed solution.
+ * @param destroyedVertices The vertices unlabeled by DestroySolution.
+ * @param changes Undo log receiving the (vertex, previous label) pairs.
+ */
+
+void AntColonyOptimization::rebuildSolution(DominationState& state, const std::vector<size_t>& destroyedVertices,
+                                            std::vector<std::pair<size_t, int>>& changes) {
+    PROFILE_SCOPE("ACO::rebuildSolution");
+    std::mt19937& seed = Random::engine();
+
+    std::vector<size_t> region;
+    std::vector<bool> inRegion(state.getLabels().size(), false);
+
+    auto addToRegion = [&](size_t vertex) {
+        if (!inRegion[vertex]) {
+            inRegion[vertex] = true;
+            region.push_back(vertex);
+        }
+    };
+
+    for (const auto& vertex: destroyedVertices) {
+        addToRegion(vertex);
+        for (const auto& neighbor: this->graph.getAdjacencyList(vertex))
+            addToRegion(neighbor);
+    }
+
+    std::vector<size_t> residual;
+    for (const auto& vertex: region)
+        if (!state.isDominated(vertex))
+            residual.push_back(vertex);
+
+    size_t regionSize = region.size();
+
+    while (!residual.empty()) {
+        size_t vertex = chooseResidualVertex(state, residual, seed);
+        bool isolated = true;
+
+        for (const auto& neighbor: this->graph.getAdjacencyList(vertex)) {
+            if (!state.isDominated(neighbor)) {
+                isolated = false;
+                break;
+            }
+        }
+
+        relabel(state, vertex, isolated ? 2 : 3, changes);
+
+        if (!isolated)
+            for (const auto& neighbor: this->graph.getAdjacencyList(vertex))
+                addToRegion(neighbor);
+
+        residual.erase(std::remove_if(residual.begin(), residual.end(),
+            [&](size_t v) { return state.isDominated(v); }), residual.end());
+    }
+
+    for (const auto& vertex: destroyedVertices)
+        if (state.getLabel(vertex) == -1)
+            relabel(state, vertex, 0, changes);
+
+    std::vector<int> twoOrZeroLabeledVertices;
+    for (size_t i = 0; i < regionSize; ++i)
+        if ((state.getLabel(region[i]) == 0) || (state.getLabel(region[i]) == 2))
+            twoOrZeroLabeledVertices.push_back(region[i]);
+
+    size_t itr = this->parameters.addVerticesRate * twoOrZeroLabeledVertices.size();
+
+    while (itr != 0 && !twoOrZeroLabeledVertices.empty()) {
+        size_t index = chooseVertex(twoOrZeroLabeledVertices);
+        size_t vertex = twoOrZeroLabeledVertices[index];
+        relabel(state, vertex, 3, changes);
+
+        for (const auto& neighbor: this->graph.getAdjacencyList(vertex))
+            addToRegion(neighbor);
+
+        twoOrZeroLabeledVertices.erase(twoOrZeroLabeledVertices.begin() + index);
+        --itr;
+    }
+
+    std::sort(region.begin(), region.end(),
+        [&](size_t a, size_t b) { return reducedBefore(a, b); });
+
+    for (const auto& vertex: region) {
+        int label = state.getLabel(vertex);
+
+        if (label == 3 || label == 2) {
+            if (state.canRelabel(vertex, 0))
+                relabel(state, vertex, 0, changes);
+            else if (label == 3 && state.canRelabel(vertex, 2))
+                relabel(state, vertex, 2, changes);
+        }
+    }
+}
+
+/**
+ * @brief Chooses a vertex of the residual graph to be labeled.
+ *
+ * Mirrors chooseVertex(Graph&): with probability `selectionVertexRateConstructSolution` a
+ * pheromone-weighted roulette is used, otherwise the vertex maximizing
+ * attractiveness(residual degree + 1) is taken. The residual degree is the number of
+ * undominated neighbors.
+ */
+
+size_t AntColonyOptimization::chooseResidualVertex(const DominationState& state,
+                                                   const std::vector<size_t>& residual,
+                                                   std::mt19937& seed) {
+    float selectionVertexRateConstructSolution = this->parameters.selectionVertexRateConstructSolution;
+    std::uniform_real_distribution<float> probabilityGap(0.0, 1.0);
+    std::vector<float> values(residual.size(), 0.0f);
+    float totalValue = 0.0f;
+
+    for (size_t i = 0; i < residual.size(); ++i) {
+        size_t residualDegree = 0;
+        for (const auto& neighbor: this->graph.getAdjacencyList(residual[i]))
+            if (!state.isDominated(neighbor))
+                ++residualDegree;
+
+        values[i] = attractiveness(residualDegree + 1, residual[i]);
+        totalValue += values[i];
+    }
+
+    if ((selectionVertexRateConstructSolution < probabilityGap(seed)) || (totalValue <= 0.0f))
+        return residual[std::max_element(values.begin(), values.end()) - values.begin()];
+
+    float randomValue = probabilityGap(seed) * totalValue;
+    float cumulativeSum = 0.0f;
+
+    for (size_t i = 0; i < residual.size(); ++i) {
+        cumulativeSum += values[i];
+        if (randomValue <= cumulativeSum)
+            return residual[i];
+    }
+
+    return residual.back();
+}
+
+/**
+ * @brief Improves a solution with Reduced Variable Neighborhood Search.
+ *
+ * Each iteration destroys part of the incumbent (DestroySolution) and repairs only the destroyed
+ * region (rebuildSolution). The candidate is accepted if it is lighter, resetting the neighborhood
+ * to the first one; otherwise the changes are undone and the next, more destructive, neighborhood
+ * is tried. The search stops after `maxRVNSnoImprovementIterations` iterations without improvement
+ * or `maxRVNSiterations` iterations in total, or when the per-ant time budget is exhausted.
+ *
+ * @param solution A feasible solution.
+ * @return The improved solution.
+ */
+
 std::vector<int> AntColonyOptimization::RVNS(std::vector<int> solution) {
+    PROFILE_SCOPE("ACO::RVNS");
     size_t currentNoImprovementIteration = 0;
-    std::vector<int> temp = solution;
+    size_t iteration = 0;
+    DominationState state(this->graph, solution);
+    std::vector<std::pair<size_t, int>> changes;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double, std::milli>(timeBudgetRVNS);
     currentRVNSnumber = 1;
 
-    while ((currentNoImprovementIteration < maxRVNSnoImprovementIterations) && (maxRVNSiterations > 0)) {
-        destroySolution(solution);
-        constructSolution(solution);
-        extendSolution(solution);
-        reduceSolution(solution);
+    ++statisticsRVNS.calls;
+
+    while ((currentNoImprovementIteration < this->parameters.maxRVNSnoImprovementIterations) &&
+           (iteration < this->parameters.maxRVNSiterations) && !isCancelled()) {
+        auto start = std::chrono::steady_clock::now();
+        size_t weight = state.getWeight();
+
+        if ((timeBudgetRVNS > 0.0) && (start >= deadline))
+            break;
 
-        if (summation(temp) < summation(solution)) {
-            solution = temp;
+        changes.clear();
+        std::vector<size_t> destroyedVertices = destroySolution(state, currentRVNSnumber, changes);
+        rebuildSolution(state, destroyedVertices, changes);
+
+        if (state.getWeight() < weight) {
             currentRVNSnumber = 1;
             currentNoImprovementIteration = 0;
+            ++statisticsRVNS.improvements;
         }
 
         else {
-            ++currentRVNSnumber;
+            for (auto it = changes.rbegin(); it != changes.rend(); ++it)
+                state.setLabel(it->first, it->second);
+
             ++currentNoImprovementIteration;
 
-            if (currentRVNSnumber > maxRVNSiterations)
+            if (++currentRVNSnumber > this->parameters.maxRVNSfunctions)
                 currentRVNSnumber = 1;
         }
 
-        --maxRVNSiterations;
+        ++iteration;
+        ++evaluations;
+        ++statisticsRVNS.iterations;
+        statisticsRVNS.elapsedMicroseconds += std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count();
     }
 
-    return solution;
+    return state.getLabels();
+}
+
+/**
+ * @brief Multi-start RVNS: several perturbations of the incumbent are tried at once.
+ *
+ * Each round submits `numberOfRVNSThreads` tasks to a pool of as many workers, started on the
+ * first call and kept for the later ones, so short rounds do not pay for starting threads. Task
+ * w destroys a private copy of the incumbent's domination state with neighborhood
+ * `currentRVNSnumber + w` (wrapping around `maxRVNSfunctions`), so the first rounds cover every
+ * destruction level and extra tasks repeat levels with different random destroys. Each task makes
+ * its own copy, so its pages are local to the worker's NUMA node, and when the caller is bound by
+ * Topology the workers bind to its node the first time they run a task for it. The lightest
+ * candidate of the round replaces the incumbent if it improves on it. Workers are seeded from the calling thread's
+ * engine, so a seeded run stays reproducible. The stopping criteria are those of RVNS, counted
+ * in rounds, and each round counts as one iteration in the statistics.
+ *
+ * @param solution A feasible solution.
+ * @return The improved solution.
+ */
+
+std::vector<int> AntColonyOptimization::parallelRVNS(std::vector<int> solution) {
+    PROFILE_SCOPE("ACO::parallelRVNS");
+    size_t currentNoImprovementIteration = 0;
+    size_t iteration = 0;
+    DominationState state(this->graph, solution);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double, std::milli>(timeBudgetRVNS);
+    size_t node = Topology::getBoundNode();
+    currentRVNSnumber = 1;
+
+    if (!this->poolRVNS)
+        this->poolRVNS.reset(new ThreadPool(numberOfRVNSThreads));
+
+    ++statisticsRVNS.calls;
+
+    while ((currentNoImprovementIteration < this->parameters.maxRVNSnoImprovementIterations) &&
+           (iteration < this->parameters.maxRVNSiterations) && !isCancelled()) {
+        auto start = std::chrono::steady_clock::now();
+
+        if ((timeBudgetRVNS > 0.0) && (start >= deadline))
+            break;
+
+        std::vector<std::unique_ptr<DominationState>> candidates(numberOfRVNSThreads);
+
+        for (size_t w = 0; w < numberOfRVNSThreads; ++w) {
+            size_t neighborhood = ((currentRVNSnumber - 1 + w) % this->parameters.maxRVNSfunctions) + 1;
+            unsigned int workerSeed = Random::engine()();
+
+            this->poolRVNS->submit([this, &candidates, &state, w, neighborhood, workerSeed, node]() {
+                thread_local size_t workerNode = Topology::none;
+                if ((node != Topology::none) && (node != workerNode) && Topology::bindToNode(node))
+                    workerNode = node;
+
+                std::vector<std::pair<size_t, int>> changes;
+                Random::seed(workerSeed);
+                candidates[w].reset(new DominationState(state));
+                std::vector<size_t> destroyedVertices = destroySolution(*candidates[w], neighborhood, changes);
+                rebuildSolution(*candidates[w], destroyedVertices, changes);
+            });
+        }
+
+        this->poolRVNS->wait();
+
+        size_t best = 0;
+        for (size_t w = 1; w < candidates.size(); ++w)
+            if (candidates[w]->getWeight() < candidates[best]->getWeight())
+                best = w;
+
+        if (candidates[best]->getWeight() < state.getWeight()) {
+            state = *candidates[best];
+            currentRVNSnumber = 1;
+            currentNoImprovementIteration = 0;
+            ++statisticsRVNS.improvements;
+        }
+
+        else {
+            ++currentNoImprovementIteration;
+            currentRVNSnumber = ((currentRVNSnumber - 1 + numberOfRVNSThreads) % this->parameters.maxRVNSfunctions) + 1;
+        }
+
+        ++iteration;
+        evaluations += numberOfRVNSThreads;
+        ++statisticsRVNS.iterations;
+        statisticsRVNS.elapsedMicroseconds += std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count();
+    }
+
+    return state.getLabels();
 }
 
 size_t AntColonyOptimization::chooseVertex(Graph& temp) {
-    float selectionVertexRateConstructSolution = 0.7f;    
-    std::random_device randomNumber;
-    std::mt19937 seed(randomNumber());
+    float selectionVertexRateConstructSolution = this->parameters.selectionVertexRateConstructSolution;
+    std::mt19937& seed = Random::engine();
     std::uniform_real_distribution<float> probabilityGap(0.0, 1.0);
     std::uniform_int_distribution<int> gap(0, this->graph.getOrder() - 1);
     
@@ -188,8 +703,8 @@ size_t AntColonyOptimization::chooseVertex(Graph& temp) {
     if (selectionVertexRateConstructSolution < number) {
         for (size_t i = 0; i < this->graph.getOrder(); ++i) {
             if (temp.vertexExists(i)) { 
-                if (value < (temp.getVertexDegree(i) * graphPheromone[i])) {
-                    value = temp.getVertexDegree(i) * graphPheromone[i];
+                if (value < attractiveness(temp.getVertexDegree(i), i)) {
+                    value = attractiveness(temp.getVertexDegree(i), i);
                 	vertex = i;                                                                                                                   
                 }
             }
@@ -207,7 +722,7 @@ size_t AntColonyOptimization::chooseVertex(Graph& temp) {
  * 
  * This function randomly selects an index from the `twoOrZeroLabeledVertices` vector.
  * Depending on the selection rate (`selectionVertexRateExtendSolution`), it may opt to choose
- * the vertex that maximizes the product of its degree and pheromone level.
+ * the vertex that maximizes the product of its degree and pheromone level per unit of cost.
  * 
  * @param twoOrZeroLabeledVertices Vector containing indices of vertices labeled as 0 or 2.
  * @return The index of the `twoOrZeroLabeledVertices` vector that maximizes the objective function, 
@@ -215,10 +730,9 @@ size_t AntColonyOptimization::chooseVertex(Graph& temp) {
  */
 
 size_t AntColonyOptimization::chooseVertex(std::vector<int> twoOrZeroLabeledVertices) {
-    constexpr float selectionVertexRateExtendSolution = 0.9f;
+    float selectionVertexRateExtendSolution = this->parameters.selectionVertexRateExtendSolution;
 
-    std::random_device randomNumber;
-    std::mt19937 seed(randomNumber());
+    std::mt19937& seed = Random::engine();
     std::uniform_real_distribution<float> probabilityGap(0.0, 1.0);
     std::uniform_int_distribution<int> randomIndex(0, twoOrZeroLabeledVertices.size() - 1);                                                               
 
@@ -234,7 +748,7 @@ size_t AntColonyOptimization::chooseVertex(std::vector<int> twoOrZeroLabeledVert
         for (size_t i = 0; i < twoOrZeroLabeledVertices.size(); ++i) {
             vertex = twoOrZeroLabeledVertices[i];
 
-            objectiveValue = this->graph.getVertexDegree(vertex) * graphPheromone[vertex];
+            objectiveValue = attractiveness(this->graph.getVertexDegree(vertex), vertex);
 
             if (objectiveValue > maxObjectiveValue) {
                 maxObjectiveValue = objectiveValue;
@@ -249,32 +763,35 @@ size_t AntColonyOptimization::chooseVertex(std::vector<int> twoOrZeroLabeledVert
     return choosenIndex;
 }
  
-bool AntColonyOptimization::feasible(std::vector<int> solution) {
-    bool hasNeighborWith3 = false;
+/**
+ * @brief Checks every double Roman domination constraint on the compact copy of the graph, with
+ * the feasibility kernel shared with the Genetic Algorithm (DominationRepair::isFeasible).
+ */
 
-    for (size_t i = 0; i < solution.size(); ++i) {
-        if (solution[i] == 0) {
-            hasNeighborWith3 = false;
-            for (auto& neighbor : this->graph.getAdjacencyList(i)) {
-                if (solution[neighbor] == 3) {
-                    hasNeighborWith3 = true;
-                    break; 
-                }
-            }
+bool AntColonyOptimization::feasible(const std::vector<int>& solution) const {
+    PROFILE_COUNT("ACO::feasible");
+    return DominationRepair<CompactGraph>::isFeasible(this->compactGraph, solution);
+}
 
-            if (!hasNeighborWith3) 
-                return false;
-        }
-    }
+size_t AntColonyOptimization::summation(const std::vector<int>& solution) const { return this->graph.getWeight(solution); }
 
-    return true;
+/**
+ * @brief Pheromone heuristic of a vertex that would dominate `degree` vertices: degree times
+ * pheromone, per unit of vertex cost, so cheap sites are preferred on weighted graphs. With unit
+ * costs the value is exactly degree times pheromone.
+ */
+
+float AntColonyOptimization::attractiveness(size_t degree, size_t vertex) const {
+    return degree * graphPheromone[vertex] * inverseCosts[vertex];
 }
 
-size_t AntColonyOptimization::summation(std::vector<int> solution) {
-    size_t temp = 0;
-    for (size_t i = 0; i < solution.size(); ++i)
-        temp += solution[i];
-    return temp;
+/**
+ * @brief Order in which the reduction steps try to lower labels: by degree per unit of cost,
+ * increasing, i.e. low-degree and expensive vertices first. With unit costs it is the degree order.
+ */
+
+bool AntColonyOptimization::reducedBefore(size_t a, size_t b) const {
+    return this->graph.getVertexDegree(a) * this->graph.getCost(b) < this->graph.getVertexDegree(b) * this->graph.getCost(a);
 }
 
 
@@ -289,72 +806,52 @@ bool AntColonyOptimization::delta(std::vector<int> solution, size_t vertex) {
     return solution[vertex] == 3 ? true : false; 
 }
 
-float AntColonyOptimization::getMaxPheromoneValue(std::vector<float> graphPheromone) {
-    float value = graphPheromone[0];
-
-    for (const auto& it: graphPheromone)
-        if (value < it)
-            value = it;
-    return value;
-}
+float AntColonyOptimization::getMaxPheromoneValue() const { return pheromoneSummary.maxPheromone; }
 
-float AntColonyOptimization::getMinPheromoneValue(std::vector<float> graphPheromone) {
-    float value = graphPheromone[0];                                     
-    for (const auto& it: graphPheromone) 
-        if (value > it)
-            value = it;
-    return value;                   
-}
+float AntColonyOptimization::getMinPheromoneValue() const { return pheromoneSummary.minPheromone; }
 
+/**
+ * @brief Updates the pheromones following the Hyper-Cube Framework, within the MAX-MIN bounds.
+ *
+ * The iteration-best and best-so-far solutions deposit on the vertices they label 3, each with a
+ * share proportional to its weight. Evaporation, deposit, clamping and the min/max/convergence
+ * statistics are computed by PheromoneKernel in one vectorized pass.
+ */
 
 void AntColonyOptimization::updatePheromones(std::vector<int>& currentBestSolution,                                                               
                                              std::vector<int>& bestSolution,        
-                                             std::vector<float>& pheromoneValues) {                                                               
-    size_t weightCurrentBestSolution = summation(currentBestSolution);
-    size_t weightBestSolution = summation(bestSolution); 
-    float equation = 0.0;        
-
-    for (size_t i = 0; i < graphPheromone.size(); ++i) {  
-        equation = (((weightCurrentBestSolution * delta(currentBestSolution, i) + 
-                      weightBestSolution * delta(bestSolution, i))) 
-                    / (weightCurrentBestSolution + weightBestSolution)) - graphPheromone[i];                                                      
-         
-        graphPheromone[i] += evaporationRate * equation;
-    }
+                                             PheromoneVector& graphPheromone) {                                                               
+    PROFILE_SCOPE("ACO::updatePheromones");
+    float weightCurrentBestSolution = summation(currentBestSolution);
+    float weightBestSolution = summation(bestSolution); 
+    float totalWeight = weightCurrentBestSolution + weightBestSolution;
+
+    pheromoneSummary = PheromoneKernel::update(graphPheromone.data(), currentBestSolution.data(),
+            bestSolution.data(), graphPheromone.size(),
+            weightCurrentBestSolution / totalWeight, weightBestSolution / totalWeight,
+            this->parameters.evaporationRate, this->parameters.minPheromone, this->parameters.maxPheromone);
 }
 
+/**
+ * @brief Convergence factor of the pheromones, computed by the last pheromone update.
+ */
 
-float AntColonyOptimization::computeConvergence(std::vector<float> graphPheromone) {
-    float maxPheromone = getMaxPheromoneValue(graphPheromone); 
-    float minPheromone = getMinPheromoneValue(graphPheromone); 
-    float temp = 0.0;
-
-    size_t numberOfAnts = graphPheromone.size();
-
-    for (size_t i = 0; i < numberOfAnts; ++i) {
-        temp += std::max(maxPheromone - graphPheromone[i], graphPheromone[i] - minPheromone);
-    }
-
-    this->convergenceFactor = 2 * ((temp / (numberOfAnts * (maxPheromone + minPheromone)))) - 1;
-
-    return this->convergenceFactor;
-}
+float AntColonyOptimization::computeConvergence() const { return pheromoneSummary.convergenceFactor; }
 
 size_t AntColonyOptimization::rouletteWheelSelection(Graph& temp) {
     float totalFitness = 0.0f;
     std::vector<std::pair<size_t, float>> probabilities;
 
-    std::random_device randomNumber;
-    std::mt19937 seed(randomNumber());
+    std::mt19937& seed = Random::engine();
     std::uniform_real_distribution<float> gap(0.0, 1.0);
 
     for (size_t i = 0; i < graph.getOrder(); ++i) 
         if (temp.vertexExists(i)) 
-            totalFitness += temp.getVertexDegree(i) * graphPheromone[i];
+            totalFitness += attractiveness(temp.getVertexDegree(i), i);
 
     for (size_t i = 0; i < graph.getOrder(); ++i)
         if (temp.vertexExists(i))
-            probabilities.push_back({i, ((temp.getVertexDegree(i) * graphPheromone[i]) / totalFitness)});
+            probabilities.push_back({i, attractiveness(temp.getVertexDegree(i), i) / totalFitness});
     
     float randomValue = gap(seed);
 
@@ -373,15 +870,15 @@ size_t AntColonyOptimization::rouletteWheelSelection(Graph& temp) {
 size_t AntColonyOptimization::rouletteWheelSelection(std::vector<int> twoOrZeroLabeledVertices) {
     float totalFitness = 0.0f;
     std::vector<std::pair<size_t, float>> probabilities;
-    std::random_device randomNumber;
-    std::mt19937 seed(randomNumber());
+    std::mt19937& seed = Random::engine();
     std::uniform_real_distribution<float> gap(0.0, 1.0);
 
     for (size_t i = 0; i < twoOrZeroLabeledVertices.size(); ++i) 
-        totalFitness += graph.getVertexDegree(twoOrZeroLabeledVertices[i]) * graphPheromone[twoOrZeroLabeledVertices[i]];
+        totalFitness += attractiveness(graph.getVertexDegree(twoOrZeroLabeledVertices[i]), twoOrZeroLabeledVertices[i]);
     
     for (size_t i = 0; i < twoOrZeroLabeledVertices.size(); ++i)
-        probabilities.push_back({i, ((graph.getVertexDegree(twoOrZeroLabeledVertices[i]) * graphPheromone[twoOrZeroLabeledVertices[i]]) / totalFitness)});
+        probabilities.push_back({i, attractiveness(graph.getVertexDegree(twoOrZeroLabeledVertices[i]),
+                                                   twoOrZeroLabeledVertices[i]) / totalFitness});
 
     float randomValue = gap(seed);
                                              
@@ -397,3 +894,221 @@ size_t AntColonyOptimization::rouletteWheelSelection(std::vector<int> twoOrZeroL
 
 
 std::vector<int> AntColonyOptimization::getBestSolution() { return this->bestSolution; }
+
+const RVNSStatistics& AntColonyOptimization::getRVNSStatistics() const { return this->statisticsRVNS; }
+
+/**
+ * @brief Enables the LocalSearch daemon action, which descends from every ant's solution after
+ * RVNS; disabled by default.
+ */
+
+void AntColonyOptimization::setLocalSearch(bool enabled) { this->localSearchEnabled = enabled; }
+
+/**
+ * @brief Checks the tunables before a run uses them.
+ *
+ * @throws std::invalid_argument if a rate lies outside [0, 1], the evaporation rate is 0, the
+ *         pheromone or destruction bounds are not ordered, or there is no RVNS neighborhood.
+ */
+
+void ACOParameters::check() const {
+    auto rate = [](float value) { return (value >= 0.0f) && (value <= 1.0f); };
+
+    if (!rate(this->evaporationRate) || (this->evaporationRate == 0.0f))
+        throw std::invalid_argument("The evaporation rate must lie in (0, 1]");
+    if (!rate(this->minPheromone) || !rate(this->maxPheromone) || (this->minPheromone > this->maxPheromone))
+        throw std::invalid_argument("The pheromone bounds must satisfy 0 <= min <= max <= 1");
+    if (!rate(this->minDestructionRate) || !rate(this->maxDestructionRate)
+        || (this->minDestructionRate > this->maxDestructionRate))
+        throw std::invalid_argument("The destruction rates must satisfy 0 <= min <= max <= 1");
+    if (this->maxRVNSfunctions == 0)
+        throw std::invalid_argument("RVNS needs at least one neighborhood");
+    if (!rate(this->addVerticesRate) || !rate(this->selectionVertexRateConstructSolution)
+        || !rate(this->selectionVertexRateExtendSolution))
+        throw std::invalid_argument("The add-vertices and selection rates must lie in [0, 1]");
+}
+
+/**
+ * @brief Replaces the tunables of the ACO and its RVNS (see ACOParameters).
+ *
+ * @throws std::invalid_argument if they fail ACOParameters::check.
+ */
+
+void AntColonyOptimization::setParameters(const ACOParameters& parameters) {
+    parameters.check();
+    this->parameters = parameters;
+}
+
+const ACOParameters& AntColonyOptimization::getParameters() const { return this->parameters; }
+
+/**
+ * @brief Sets the iteration limit of the next run(), e.g. a short one after a warm start.
+ */
+
+void AntColonyOptimization::setIterations(size_t iterations) { this->iterations = iterations; }
+
+/**
+ * @brief Sets the number of worker threads used by RVNS; 1 keeps the sequential RVNS.
+ */
+
+void AntColonyOptimization::setRVNSThreads(size_t numberOfRVNSThreads) {
+    numberOfRVNSThreads = std::max<size_t>(1, numberOfRVNSThreads);
+    if (numberOfRVNSThreads != this->numberOfRVNSThreads)
+        this->poolRVNS.reset();
+    this->numberOfRVNSThreads = numberOfRVNSThreads;
+}
+
+/**
+ * @brief Sets the wall-clock budget of each RVNS call, i.e. of each ant; 0 disables it.
+ */
+
+void AntColonyOptimization::setRVNSTimeBudget(double milliseconds) { this->timeBudgetRVNS = milliseconds; }
+
+/**
+ * @brief Share of RVNS iterations whose candidate replaced the incumbent.
+ */
+
+double RVNSStatistics::getImprovementRate() const {
+    return iterations == 0 ? 0.0 : static_cast<double>(improvements) / iterations;
+}
+
+/**
+ * @brief Mean wall time of one RVNS iteration, in microseconds.
+ */
+
+double RVNSStatistics::getTimePerIteration() const {
+    return iterations == 0 ? 0.0 : elapsedMicroseconds / iterations;
+}
+
+void AntColonyOptimization::setStopCriteria(const ACOStopCriteria& stopCriteria) { this->stopCriteria = stopCriteria; }
+
+/**
+ * @brief Sets when and how the colony restarts.
+ *
+ * @param restartPolicy What a restart resets; RestartPolicy::None disables restarts.
+ * @param convergenceThreshold Convergence factor above which the colony restarts.
+ * @param noImprovementIterations Iterations without improving the restart-best solution
+ *        after which the colony restarts; 0 disables the stagnation detector.
+ */
+
+void AntColonyOptimization::setRestartPolicy(RestartPolicy restartPolicy, float convergenceThreshold,
+                                             size_t noImprovementIterations) {
+    this->restartPolicy = restartPolicy;
+    this->restartConvergenceThreshold = convergenceThreshold;
+    this->restartNoImprovementIterations = noImprovementIterations;
+}
+
+/**
+ * @brief Parses "none", "pheromones" (ResetPheromones) or "pheromones-and-best"
+ * (ResetPheromonesAndRestartBest).
+ *
+ * @throws std::invalid_argument for any other name.
+ */
+
+RestartPolicy ACORestartSettings::parse(const std::string& name) {
+    if (name == "none")
+        return RestartPolicy::None;
+    if (name == "pheromones")
+        return RestartPolicy::ResetPheromones;
+    if (name == "pheromones-and-best")
+        return RestartPolicy::ResetPheromonesAndRestartBest;
+
+    throw std::invalid_argument("Unknown restart policy " + name);
+}
+
+void AntColonyOptimization::setIterationCallback(std::function<void(const ACOIterationTelemetry&)> iterationCallback) {
+    this->iterationCallback = iterationCallback;
+}
+
+/**
+ * @brief Sets a flag, owned by the caller, that another thread raises to stop the run early.
+ *
+ * The flag is polled between ants and between RVNS iterations; once it is raised the current
+ * iteration is finished with the ants already built and the run stops with StopReason::Cancelled.
+ * A null pointer disables cancellation.
+ */
+
+void AntColonyOptimization::setCancellationFlag(const std::atomic<bool>* cancellationFlag) {
+    this->cancellationFlag = cancellationFlag;
+}
+
+/**
+ * @brief Shares incumbents with an algorithm running concurrently (see exchangeIncumbent); a
+ * null pointer disables sharing.
+ */
+
+void AntColonyOptimization::setSharedIncumbent(SharedIncumbent* sharedIncumbent) {
+    this->sharedIncumbent = sharedIncumbent;
+}
+
+/**
+ * @brief Sets a lower bound on γdR, e.g. DominationBounds::lowerBound(graph); a solution of that
+ * weight is optimal, so the run stops as soon as one is found. 0 disables the check.
+ */
+
+void AntColonyOptimization::setLowerBound(size_t lowerBound) { this->lowerBound = lowerBound; }
+
+/**
+ * @brief Continues the colony on a changed version of its graph: the next run() keeps the
+ * pheromones of the last one, which are per vertex and survive edge changes, and starts from
+ * `solution` as its restart-best and best-so-far solution instead of the all-3 labeling.
+ *
+ * @param graph The graph after the change, with the same vertices.
+ * @param solution A double Roman dominating function of `graph`, e.g. the last best solution repaired.
+ * @throws std::invalid_argument if the graph or the solution have another order.
+ */
+
+void AntColonyOptimization::warmStart(const Graph& graph, const std::vector<int>& solution) {
+    if ((graph.getOrder() != this->graph.getOrder()) || (solution.size() != graph.getOrder()))
+        throw std::invalid_argument("A warm start needs a graph and a solution of the same order");
+
+    this->graph = graph;
+    this->compactGraph = CompactGraph(graph);
+    for (size_t i = 0; i < this->inverseCosts.size(); ++i)
+        this->inverseCosts[i] = 1.0f / graph.getCost(i);
+
+    this->currentBestSolution = solution;
+    this->bestSolution = solution;
+    this->warmStarted = true;
+}
+
+/**
+ * @brief Offers the best-so-far solution to the shared incumbent and adopts the shared one when
+ * it is lighter, so the pheromone update reinforces the vertices labeled 3 in it.
+ *
+ * @return bool True if the best-so-far solution was replaced.
+ */
+
+bool AntColonyOptimization::exchangeIncumbent() {
+    size_t bestWeight = summation(bestSolution);
+    sharedIncumbent->offer(bestSolution, bestWeight, IncumbentSource::ACO);
+
+    auto shared = sharedIncumbent->load();
+    if (!shared || (shared->weight >= bestWeight))
+        return false;
+
+    bestSolution = shared->solution;
+    return true;
+}
+
+/**
+ * @brief Whether the cancellation flag is raised or the deadline of the time budget has passed.
+ */
+
+bool AntColonyOptimization::isCancelled() const {
+    if (cancellationFlag && cancellationFlag->load(std::memory_order_relaxed))
+        return true;
+    return (deadline != std::chrono::steady_clock::time_point::max()) && (std::chrono::steady_clock::now() >= deadline);
+}
+
+StopReason AntColonyOptimization::getStopReason() const { return this->stopReason; }
+
+size_t AntColonyOptimization::getNumberOfRestarts() const { return this->numberOfRestarts; }
+
+/**
+ * @brief Number of solutions evaluated: one per ant plus one per RVNS candidate.
+ */
+
+size_t AntColonyOptimization::getNumberOfEvaluations() const { return this->evaluations; }
+
+const std::vector<ACOIterationTelemetry>& AntColonyOptimization::getTelemetry() const { return this->telemetry; }
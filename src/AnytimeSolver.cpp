@@ -0,0 +1,289 @@
+#include "AnytimeSolver.hpp"
+#include "DoubleRomanDomination.hpp"
+#include "DominationState.hpp"
+#include "DominationBounds.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Creates a solver over a copy of the graph with the parameters of the Genetic Algorithm
+ * and of the ACO; nothing runs until start() or solve() is called.
+ *
+ * @param graph The graph.
+ * @param populationSize Population size of the Genetic Algorithm.
+ * @param generations Generations of the Genetic Algorithm.
+ * @param heuristic Heuristic (1, 2 or 3) creating the initial population.
+ * @param numberOfAnts Ants per ACO iteration.
+ * @param iterations ACO iterations.
+ * @param numberOfRVNSThreads Workers of the ACO's RVNS.
+ */
+
+AnytimeSolver::AnytimeSolver(Graph& graph, size_t populationSize, size_t generations, short int heuristic,
+                             size_t numberOfAnts, size_t iterations, size_t numberOfRVNSThreads)
+    : graph(graph), populationSize(populationSize), generations(generations), heuristic(heuristic),
+      numberOfAnts(numberOfAnts), iterations(iterations), numberOfRVNSThreads(numberOfRVNSThreads),
+      lowerBound(DominationBounds::lowerBound(graph)), algorithm(SolverAlgorithm::Both), stopReason(StopReason::IterationLimit), stopRequested(false),
+      finished(true), cancelled(false) {
+    this->incumbent = this->initialIncumbent();
+}
+
+/**
+ * @brief The all-2 labeling, feasible on every graph, weighed with the vertex costs.
+ */
+
+SolverIncumbent AnytimeSolver::initialIncumbent() const {
+    std::vector<int> solution(this->graph.getOrder(), 2);
+    size_t weight = this->graph.getWeight(solution);
+    return { std::move(solution), weight, "initial", 0, 0.0 };
+}
+
+/**
+ * @brief Cancels a running solve and waits for its threads.
+ */
+
+AnytimeSolver::~AnytimeSolver() {
+    this->cancel();
+    this->join();
+}
+
+/**
+ * @brief Selects what a solve runs: the Genetic Algorithm, the ACO, or both one after the other
+ * (the default, as DoubleRomanDomination does), sharing the limits.
+ */
+
+void AnytimeSolver::setAlgorithm(SolverAlgorithm algorithm) { this->algorithm = algorithm; }
+
+/**
+ * @brief Sets the function called, on the solving thread, every time the incumbent improves.
+ *
+ * The callback must return quickly, since the search waits for it; it may call cancel().
+ */
+
+void AnytimeSolver::setImprovementCallback(std::function<void(const SolverIncumbent&)> improvementCallback) {
+    this->improvementCallback = improvementCallback;
+}
+
+/**
+ * @brief Starts a solve on a background thread and returns immediately.
+ *
+ * The solve stops at the first of: the configured generations/iterations (capped by
+ * `maxIterations`), the wall-clock budget `timeBudget` (seconds), the incumbent reaching
+ * `targetWeight` or the lower bound (getLowerBound(), reported as StopReason::LowerBound), or
+ * cancel(); a zero disables a limit. The budget is enforced by a watchdog that
+ * raises the cancellation flag polled by the algorithms, so the solve returns within one ant
+ * or one generation of the deadline.
+ *
+ * The incumbent starts as the all-2 labeling, which is always a double Roman dominating function,
+ * so getIncumbent() returns a feasible solution at any time.
+ *
+ * @param limits The limits of the solve.
+ * @throws std::logic_error if a solve is already running.
+ */
+
+void AnytimeSolver::start(const SolverLimits& limits) {
+    if (this->isRunning())
+        throw std::logic_error("A solve is already running");
+
+    this->join();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->limits = limits;
+        this->incumbent = this->initialIncumbent();
+        this->stopReason = StopReason::IterationLimit;
+        this->stopRequested = false;
+        this->finished = false;
+        this->cancelled = false;
+        this->startTime = std::chrono::steady_clock::now();
+    }
+
+    this->worker = std::thread(&AnytimeSolver::work, this);
+
+    if (limits.timeBudget > 0.0)
+        this->watchdog = std::thread(&AnytimeSolver::watch, this);
+}
+
+/**
+ * @brief Starts a solve, blocks until it stops and returns its final incumbent.
+ */
+
+SolverIncumbent AnytimeSolver::solve(const SolverLimits& limits) {
+    this->start(limits);
+    this->wait();
+    return this->getIncumbent();
+}
+
+/**
+ * @brief Asks the running solve to stop; safe to call from any thread, and a no-op when idle.
+ */
+
+void AnytimeSolver::cancel() { this->requestStop(StopReason::Cancelled); }
+
+/**
+ * @brief Blocks until the current solve finishes.
+ */
+
+void AnytimeSolver::wait() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->finishedCondition.wait(lock, [this]() { return this->finished; });
+}
+
+/**
+ * @brief Blocks until the current solve finishes or `seconds` elapse.
+ *
+ * @return bool True if the solve has finished.
+ */
+
+bool AnytimeSolver::waitFor(double seconds) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    return this->finishedCondition.wait_for(lock, std::chrono::duration<double>(seconds),
+                                            [this]() { return this->finished; });
+}
+
+bool AnytimeSolver::isRunning() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return !this->finished;
+}
+
+/**
+ * @brief Returns a copy of the best solution found so far; safe to call while solving.
+ */
+
+SolverIncumbent AnytimeSolver::getIncumbent() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->incumbent;
+}
+
+/**
+ * @brief Why the last solve stopped; StopReason::IterationLimit when it ran to completion.
+ */
+
+StopReason AnytimeSolver::getStopReason() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->stopReason;
+}
+
+/**
+ * @brief Lower bound on gamma2R; an incumbent of that weight is optimal and ends the solve.
+ */
+
+size_t AnytimeSolver::getLowerBound() const { return this->lowerBound; }
+
+/**
+ * @brief Body of the solving thread: runs the selected algorithms, offering their best solutions
+ * to the incumbent as they improve.
+ */
+
+void AnytimeSolver::work() {
+    size_t cap = this->limits.maxIterations;
+
+    if (this->algorithm != SolverAlgorithm::ACO) {
+        size_t generations = cap > 0 ? std::min(this->generations, cap) : this->generations;
+        GeneticOperators operators;
+        operators.heuristic = (this->heuristic == 2) || (this->heuristic == 3) ? this->heuristic : 1;
+
+        GeneticAlgorithm geneticAlgorithm(this->graph, this->populationSize, this->graph.getOrder(), generations);
+        geneticAlgorithm.setOperators(operators);
+        geneticAlgorithm.setCancellationFlag(&this->cancelled);
+        geneticAlgorithm.setGenerationCallback([this](size_t generation, const std::vector<int>& best) {
+            this->offer(best, "ga", generation);
+        });
+
+        geneticAlgorithm.run(generations);
+        this->offer(geneticAlgorithm.getBestSolution(), "ga", generations);
+    }
+
+    if ((this->algorithm != SolverAlgorithm::GeneticAlgorithm) && !this->cancelled) {
+        size_t iterations = cap > 0 ? std::min(this->iterations, cap) : this->iterations;
+
+        AntColonyOptimization ACO(this->graph, iterations, this->numberOfAnts);
+        ACO.setRVNSThreads(this->numberOfRVNSThreads);
+        ACO.setCancellationFlag(&this->cancelled);
+        ACO.setIterationCallback([this, &ACO](const ACOIterationTelemetry& record) {
+            this->offer(ACO.getBestSolution(), "aco", record.iteration);
+        });
+
+        ACO.run();
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->finished = true;
+    this->finishedCondition.notify_all();
+}
+
+/**
+ * @brief Body of the watchdog thread: raises the cancellation flag at the deadline unless the
+ * solve has finished before.
+ */
+
+void AnytimeSolver::watch() {
+    auto deadline = this->startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(this->limits.timeBudget));
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    if (!this->finishedCondition.wait_until(lock, deadline, [this]() { return this->finished; })) {
+        lock.unlock();
+        this->requestStop(StopReason::TimeBudget);
+    }
+}
+
+/**
+ * @brief Replaces the incumbent with `solution` if it is a lighter double Roman dominating
+ * function, then notifies the callback and stops the solve if the target weight is reached.
+ *
+ * Only the solving thread writes the incumbent, so the feasibility check runs unlocked.
+ */
+
+void AnytimeSolver::offer(const std::vector<int>& solution, const char* algorithm, size_t iteration) {
+    size_t weight = this->graph.getWeight(solution);
+
+    if ((solution.size() != this->graph.getOrder()) || (weight >= this->getIncumbent().weight))
+        return;
+
+    DominationState state(this->graph, solution);
+    for (size_t i = 0; i < solution.size(); ++i)
+        if ((solution[i] < 0) || !state.isDominated(i))
+            return;
+
+    SolverIncumbent improved = { solution, weight, algorithm, iteration,
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - this->startTime).count() };
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->incumbent = improved;
+    }
+
+    if (this->improvementCallback)
+        this->improvementCallback(improved);
+
+    if (weight <= this->lowerBound)
+        this->requestStop(StopReason::LowerBound);
+
+    if ((this->limits.targetWeight > 0) && (weight <= this->limits.targetWeight))
+        this->requestStop(StopReason::TargetWeight);
+}
+
+/**
+ * @brief Raises the cancellation flag; the first reason given while solving is the one reported.
+ */
+
+void AnytimeSolver::requestStop(StopReason reason) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    if (this->finished)
+        return;
+
+    if (!this->stopRequested) {
+        this->stopRequested = true;
+        this->stopReason = reason;
+    }
+
+    this->cancelled = true;
+}
+
+void AnytimeSolver::join() {
+    if (this->worker.joinable())
+        this->worker.join();
+    if (this->watchdog.joinable())
+        this->watchdog.join();
+}
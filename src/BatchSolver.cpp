@@ -0,0 +1,383 @@
+#include "BatchSolver.hpp"
+#include "GeneticAlgorithm.hpp"
+#include "AntColonyOptimization.hpp"
+#include "DoubleRomanDomination.hpp"
+#include "DominationState.hpp"
+#include "GraphReduction.hpp"
+#include "DominationBounds.hpp"
+#include "ExactSolver.hpp"
+#include "TabuSearch.hpp"
+#include "Random.hpp"
+#include <chrono>
+#include <dirent.h>
+#include <stdexcept>
+#include <sys/stat.h>
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Prepares a batch: starts the worker pool and opens the output file, whose CSV header is
+ * written at once.
+ *
+ * @param settings Input, output, algorithms, seeds, algorithm parameters and scheduling thresholds.
+ * @throws std::invalid_argument if the settings are not valid (see checkSettings).
+ * @throws std::runtime_error if the output file cannot be opened.
+ */
+
+BatchSolver::BatchSolver(const BatchSettings& settings)
+    : settings(settings), output(settings.output), numberOfResults(0), numberOfFailures(0), numberOfFailedTasks(0),
+      pool(settings.numberOfThreads, settings.affinity) {
+    checkSettings(settings);
+
+    if (!this->output)
+        throw std::runtime_error("Cannot open " + settings.output);
+
+    this->output << "graph,order,size,algorithm,seed,gamma2r,lower_bound,feasible,load_ms,solve_ms,worker,node" << std::endl;
+}
+
+/**
+ * @brief Solves every graph of the input with every algorithm and seed.
+ *
+ * Each graph becomes a loading task; graphs are submitted largest file first, so the longest
+ * solves start early and the small ones fill the gaps at the end. Once loaded, a graph with fewer
+ * than `smallGraphOrder` vertices is solved for all (algorithm, seed) pairs by the same task,
+ * which keeps it hot in cache and avoids scheduling many tiny tasks. Larger graphs spawn one task
+ * per pair on the loading worker's deque, where idle workers steal them, and graphs with at least
+ * `largeGraphOrder` vertices also run the ACO's RVNS on `largeGraphRVNSThreads` threads.
+ *
+ * Results are appended to the output as soon as each solve finishes. With a vertex ordering, each
+ * graph is relabeled right after loading, and the load time includes the relabeling; weights and
+ * feasibility do not depend on the ids.
+ *
+ * With an affinity policy the workers are bound to NUMA nodes (see ThreadPool), and every solver
+ * builds its copies of the graph and its buffers on the worker that runs it. With `replicateGraph`
+ * the shared graph itself, which the bound, the feasibility check and the tabu and local searches
+ * read in place, is copied once per node by the first task that runs there.
+ *
+ * @return size_t The number of results written.
+ */
+
+size_t BatchSolver::run() {
+    std::vector<std::pair<off_t, std::string>> graphs;
+
+    for (const auto& path: listGraphs(this->settings.input)) {
+        struct stat status;
+        graphs.push_back({ stat(path.c_str(), &status) == 0 ? status.st_size : 0, path });
+    }
+
+    std::sort(graphs.begin(), graphs.end(), [](const std::pair<off_t, std::string>& a,
+                                               const std::pair<off_t, std::string>& b) {
+        return a.first > b.first;
+    });
+
+    for (const auto& graph: graphs) {
+        std::string path = graph.second;
+        this->pool.submit([this, path]() { this->loadAndSchedule(path); });
+    }
+
+    this->pool.wait();
+    this->output.flush();
+
+    return this->numberOfResults;
+}
+
+/**
+ * @brief Number of graphs that could not be loaded.
+ */
+
+size_t BatchSolver::getNumberOfFailures() const { return this->numberOfFailures; }
+
+/**
+ * @brief Number of (graph, algorithm, seed) tasks that threw instead of producing a result.
+ */
+
+size_t BatchSolver::getNumberOfFailedTasks() const { return this->numberOfFailedTasks; }
+
+/**
+ * @brief Lists the graph files of a batch.
+ *
+ * @param input A directory, whose `.txt` files are taken in name order, or a manifest listing one
+ *        graph file per line; blank lines and lines starting with '#' are skipped, and relative
+ *        paths are relative to the manifest's directory.
+ * @return std::vector<std::string> The paths of the graph files.
+ * @throws std::runtime_error if the input cannot be read.
+ */
+
+std::vector<std::string> BatchSolver::listGraphs(const std::string& input) {
+    std::vector<std::string> paths;
+    DIR* directory = opendir(input.c_str());
+
+    if (directory) {
+        for (dirent* entry = readdir(directory); entry; entry = readdir(directory)) {
+            std::string name = entry->d_name;
+            if ((name.size() > 4) && (name.substr(name.size() - 4) == ".txt"))
+                paths.push_back(input + "/" + name);
+        }
+
+        closedir(directory);
+        std::sort(paths.begin(), paths.end());
+        return paths;
+    }
+
+    std::ifstream manifest(input);
+    if (!manifest)
+        throw std::runtime_error("Cannot read " + input);
+
+    size_t slash = input.find_last_of('/');
+    std::string base = slash == std::string::npos ? "" : input.substr(0, slash + 1);
+    std::string line;
+
+    while (std::getline(manifest, line)) {
+        line.erase(0, line.find_first_not_of(" \t"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+
+        if (line.empty() || (line[0] == '#'))
+            continue;
+
+        paths.push_back(line[0] == '/' ? line : base + line);
+    }
+
+    return paths;
+}
+
+/**
+ * @brief Checks the settings before any task starts, so a bad parameter stops the batch at once
+ * rather than on a worker.
+ *
+ * @throws std::invalid_argument if an algorithm is not "ga", "aco", "hybrid" or "tabu", optionally
+ *         followed by "+reduce", which directed graphs do not support, if the GA operators or
+ *         the ACO parameters fail their checks, if the GA or the hybrid runs with a population
+ *         below 2, if a time budget is negative or if the restart threshold lies outside [0, 1].
+ */
+
+void BatchSolver::checkSettings(const BatchSettings& settings) {
+    settings.operators.check();
+    settings.aco.check();
+    if ((settings.timeBudget < 0.0) || (settings.timeBudgetRVNS < 0.0) || (settings.stopACO.timeBudget < 0.0)
+        || (settings.tabu.timeBudget < 0.0))
+        throw std::invalid_argument("Time budgets must not be negative");
+    if ((settings.restartACO.convergenceThreshold < 0.0f) || (settings.restartACO.convergenceThreshold > 1.0f))
+        throw std::invalid_argument("The restart threshold must lie in [0, 1]");
+
+    for (const auto& algorithm: settings.algorithms) {
+        std::string name = algorithm.substr(0, algorithm.find('+'));
+        if (((name != "ga") && (name != "aco") && (name != "hybrid") && (name != "tabu"))
+            || ((name != algorithm) && (algorithm.substr(name.size()) != "+reduce")))
+            throw std::invalid_argument("Unknown algorithm " + algorithm);
+        if (settings.directed && (name != algorithm))
+            throw std::invalid_argument(algorithm + " needs undirected graphs");
+        if (((name == "ga") || (name == "hybrid")) && (settings.populationSize < 2))
+            throw std::invalid_argument(algorithm + " needs a population of at least 2");
+    }
+}
+
+void BatchSolver::loadAndSchedule(const std::string& path) {
+    auto start = Clock::now();
+    std::shared_ptr<Graph> graph;
+
+    try {
+        graph = std::make_shared<Graph>(path, this->settings.directed);
+        if (this->settings.ordering != OrderingStrategy::Identity)
+            graph = std::make_shared<Graph>(VertexOrdering(*graph, this->settings.ordering).apply(*graph));
+    } catch (const std::exception& exception) {
+        std::lock_guard<std::mutex> lock(this->outputMutex);
+        std::cerr << "Skipping " << path << ": " << exception.what() << std::endl;
+        ++this->numberOfFailures;
+        return;
+    }
+
+    double loadMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    size_t numberOfRVNSThreads = graph->getOrder() >= this->settings.largeGraphOrder
+                               ? this->settings.largeGraphRVNSThreads : 1;
+
+    std::vector<std::pair<std::string, unsigned int>> tasks;
+    for (const auto& algorithm: this->settings.algorithms)
+        for (size_t i = 0; i < this->settings.seeds; ++i)
+            tasks.push_back({ algorithm, static_cast<unsigned int>(this->settings.firstSeed + i) });
+
+    auto replicas = std::make_shared<NodeReplicas<Graph>>(graph, this->settings.replicateGraph);
+
+    if (graph->getOrder() < this->settings.smallGraphOrder) {
+        this->solveTasks(replicas, path, loadMilliseconds, tasks, numberOfRVNSThreads);
+        return;
+    }
+
+    for (const auto& task: tasks) {
+        std::vector<std::pair<std::string, unsigned int>> single = { task };
+        this->pool.submit([this, replicas, path, loadMilliseconds, single, numberOfRVNSThreads]() {
+            this->solveTasks(replicas, path, loadMilliseconds, single, numberOfRVNSThreads);
+        });
+    }
+}
+
+void BatchSolver::solveTasks(std::shared_ptr<NodeReplicas<Graph>> graph, const std::string& path,
+                             double loadMilliseconds, const std::vector<std::pair<std::string, unsigned int>>& tasks,
+                             size_t numberOfRVNSThreads) {
+    for (const auto& task: tasks) {
+        BatchResult result;
+        try {
+            result = this->solve(graph->local(), task.first, task.second, numberOfRVNSThreads);
+        } catch (const std::exception& exception) {
+            std::lock_guard<std::mutex> lock(this->outputMutex);
+            std::cerr << "Failed " << task.first << " with seed " << task.second << " on " << path << ": "
+                      << exception.what() << std::endl;
+            ++this->numberOfFailedTasks;
+            continue;
+        }
+
+        result.graph = path;
+        result.loadMilliseconds = loadMilliseconds;
+        this->write(result);
+    }
+}
+
+/**
+ * @brief Runs one algorithm ("ga", "aco", "hybrid" or "tabu") with one seed on the calling worker.
+ *
+ * The worker's random engine is reseeded, so a (graph, algorithm, seed) result does not depend on
+ * which worker ran it or on what ran before. The lower bound of DominationBounds is reported with
+ * every result.
+ */
+
+BatchResult BatchSolver::solve(Graph& graph, const std::string& algorithm, unsigned int seed,
+                               size_t numberOfRVNSThreads) {
+    BatchResult result = {};
+    result.order = graph.getOrder();
+    result.size = graph.getSize();
+    result.algorithm = algorithm;
+    result.seed = seed;
+    result.lowerBound = DominationBounds::lowerBound(graph);
+    result.worker = ThreadPool::getCurrentWorker();
+    result.node = Topology::getCurrentNode();
+
+    Random::seed(seed);
+    auto start = Clock::now();
+    std::vector<int> solution = solveGraph(this->settings, graph, algorithm, numberOfRVNSThreads);
+
+    result.solveMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    result.feasible = solution.size() == graph.getOrder();
+
+    result.gamma2r = graph.getWeight(solution);
+
+    if (result.feasible) {
+        DominationState state(graph, solution);
+        for (size_t i = 0; result.feasible && (i < solution.size()); ++i)
+            result.feasible = (solution[i] >= 0) && state.isDominated(i);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Runs one algorithm with the parameters of the settings on the calling thread and returns
+ * its best solution.
+ *
+ * With the "+reduce" suffix the graph is first reduced by GraphReduction and each remaining
+ * component is solved in turn by solveComponent(); in a batch the components are not spread over
+ * the pool, whose workers are already busy with the other tasks.
+ */
+
+std::vector<int> BatchSolver::solveGraph(const BatchSettings& settings, Graph& graph, const std::string& algorithm,
+                                         size_t numberOfRVNSThreads) {
+    size_t suffix = algorithm.find('+');
+    if (suffix == std::string::npos)
+        return runAlgorithm(settings, graph, algorithm, numberOfRVNSThreads);
+
+    std::string name = algorithm.substr(0, suffix);
+    GraphReduction reduction(graph);
+    return reduction.solve([&settings, &name, numberOfRVNSThreads](Graph& component) {
+        return solveComponent(settings, component, name, numberOfRVNSThreads);
+    });
+}
+
+/**
+ * @brief Solves a component of a reduced graph: exactly when it has at most 64 vertices and the
+ * search ends within `exactNodeLimit` nodes, and otherwise with the algorithm, whose solution is
+ * kept only if it is lighter than the best one the exact search found.
+ */
+
+std::vector<int> BatchSolver::solveComponent(const BatchSettings& settings, Graph& component,
+                                             const std::string& algorithm, size_t numberOfRVNSThreads) {
+    if (component.getOrder() > ExactSolver::maxOrder)
+        return runAlgorithm(settings, component, algorithm, numberOfRVNSThreads);
+
+    ExactResult exact = ExactSolver(component, settings.exactNodeLimit).solve();
+    if (exact.optimal)
+        return exact.solution;
+
+    std::vector<int> solution = runAlgorithm(settings, component, algorithm, numberOfRVNSThreads);
+    return component.getWeight(solution) < exact.weight ? solution : exact.solution;
+}
+
+/**
+ * @brief Runs "ga", "aco", "hybrid" or "tabu" on a graph and returns its best solution; the hybrid
+ * runs the Genetic Algorithm and the ACO concurrently and returns the lighter of their solutions,
+ * and the tabu search starts from the construction heuristic of the settings. Each algorithm stops
+ * early once it reaches the lower bound of the graph.
+ */
+
+std::vector<int> BatchSolver::runAlgorithm(const BatchSettings& settings, Graph& graph, const std::string& algorithm,
+                                           size_t numberOfRVNSThreads) {
+    std::vector<int> solution;
+
+    if (algorithm == "ga") {
+        GeneticAlgorithm geneticAlgorithm(graph, settings.populationSize, graph.getOrder(), settings.generations);
+        GeneticOperators operators = settings.operators;
+        operators.heuristic = (settings.heuristic == 2) || (settings.heuristic == 3) ? settings.heuristic : 1;
+        geneticAlgorithm.setLowerBound(DominationBounds::lowerBound(graph));
+        geneticAlgorithm.setOperators(operators);
+        geneticAlgorithm.setTimeBudget(settings.timeBudget);
+        geneticAlgorithm.run(settings.generations);
+        solution = geneticAlgorithm.getBestSolution();
+    }
+
+    else if (algorithm == "hybrid") {
+        DoubleRomanDomination drd(graph, settings.populationSize, graph.getOrder(), settings.generations,
+                                  settings.heuristic, settings.numberOfAnts, settings.iterations,
+                                  numberOfRVNSThreads, ExecutionMode::Hybrid, CheckpointSettings(),
+                                  settings.operators, settings.localSearchACO, settings.aco, settings.timeBudget,
+                                  settings.stopACO, settings.restartACO, settings.timeBudgetRVNS);
+        solution = drd.getGamma2rACO() <= drd.getGamma2rGeneticAlgorithm() ? drd.getSolutionACO()
+                                                                          : drd.getSolutionGeneticAlgorithm();
+    }
+
+    else if (algorithm == "tabu") {
+        Chromosome initial = settings.heuristic == 2 ? DoubleRomanDomination::heuristic2(graph)
+                           : settings.heuristic == 3 ? DoubleRomanDomination::heuristic3(graph)
+                           : DoubleRomanDomination::heuristic1(graph);
+        TabuSearch tabuSearch(graph, settings.tabu);
+        tabuSearch.setLowerBound(DominationBounds::lowerBound(graph));
+        tabuSearch.run(initial.genes);
+        solution = tabuSearch.getBestSolution();
+    }
+
+    else {
+        AntColonyOptimization ACO(graph, settings.iterations, settings.numberOfAnts);
+        ACOStopCriteria stopCriteria = settings.stopACO;
+        if (settings.timeBudget > 0.0)
+            stopCriteria.timeBudget = settings.timeBudget;
+        ACO.setRVNSThreads(numberOfRVNSThreads);
+        ACO.setRVNSTimeBudget(settings.timeBudgetRVNS);
+        ACO.setRestartPolicy(settings.restartACO.policy, settings.restartACO.convergenceThreshold,
+                             settings.restartACO.noImprovementIterations);
+        ACO.setLowerBound(DominationBounds::lowerBound(graph));
+        ACO.setParameters(settings.aco);
+        ACO.setLocalSearch(settings.localSearchACO);
+        ACO.setStopCriteria(stopCriteria);
+        ACO.run();
+        solution = ACO.getBestSolution();
+    }
+
+    return solution;
+}
+
+void BatchSolver::write(const BatchResult& result) {
+    std::lock_guard<std::mutex> lock(this->outputMutex);
+
+    this->output << result.graph << ',' << result.order << ',' << result.size << ',' << result.algorithm << ','
+                 << result.seed << ',' << result.gamma2r << ',' << result.lowerBound << ','
+                 << (result.feasible ? "true" : "false") << ','
+                 << result.loadMilliseconds << ',' << result.solveMilliseconds << ',' << result.worker << ','
+                 << result.node << std::endl;
+    ++this->numberOfResults;
+}
@@ -0,0 +1,177 @@
+#include "Checkpoint.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+constexpr uint32_t magic = 0x43445244; // "DRDC"
+constexpr uint32_t version = 1;
+
+}
+
+/**
+ * @brief Reads the checkpoint settings of the command-line front end from the environment:
+ * DRD_CHECKPOINT is the path prefix of the files (checkpointing is off when unset),
+ * DRD_CHECKPOINT_INTERVAL the generations or iterations between two snapshots (10 by default) and
+ * DRD_RESUME, when set to anything but 0, resumes from the files found under the prefix.
+ */
+
+CheckpointSettings CheckpointSettings::fromEnvironment() {
+    CheckpointSettings settings;
+
+    if (const char* path = std::getenv("DRD_CHECKPOINT"))
+        settings.path = path;
+    if (const char* interval = std::getenv("DRD_CHECKPOINT_INTERVAL"))
+        settings.interval = std::stoul(interval);
+    if (const char* resume = std::getenv("DRD_RESUME"))
+        settings.resume = std::string(resume) != "0";
+
+    return settings;
+}
+
+/**
+ * @brief Starts a checkpoint with its header: magic number, format version, the algorithm it
+ * belongs to and the order and size of the graph, which a resume must match.
+ */
+
+CheckpointBuffer::CheckpointBuffer(CheckpointKind kind, const Graph& graph) {
+    this->write(magic);
+    this->write(version);
+    this->write(kind);
+    this->write<uint64_t>(graph.getOrder());
+    this->write<uint64_t>(graph.getSize());
+}
+
+/**
+ * @brief Writes the full state of a Mersenne Twister, so the resumed run draws the same numbers.
+ */
+
+void CheckpointBuffer::writeEngine(const std::mt19937& engine) {
+    std::ostringstream state;
+    state << engine;
+    std::string text = state.str();
+    this->writeVector(std::vector<char>(text.begin(), text.end()));
+}
+
+std::vector<char>& CheckpointBuffer::getBytes() { return this->bytes; }
+
+/**
+ * @brief Loads a checkpoint and checks its header.
+ *
+ * @throws std::runtime_error if the file cannot be read, is not a checkpoint of this version or
+ *         was written by another algorithm or for another graph.
+ */
+
+CheckpointReader::CheckpointReader(const std::string& path, CheckpointKind kind, const Graph& graph)
+    : path(path), offset(0) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Cannot open checkpoint " + path);
+
+    this->bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    if ((this->read<uint32_t>() != magic) || (this->read<uint32_t>() != version))
+        throw std::runtime_error(path + " is not a checkpoint of this version");
+    if (this->read<CheckpointKind>() != kind)
+        throw std::runtime_error(path + " was written by another algorithm");
+    if ((this->read<uint64_t>() != graph.getOrder()) || (this->read<uint64_t>() != graph.getSize()))
+        throw std::runtime_error(path + " was written for another graph");
+}
+
+void CheckpointReader::require(size_t length) {
+    if (length > this->bytes.size() - this->offset)
+        throw std::runtime_error("Truncated checkpoint " + this->path);
+}
+
+void CheckpointReader::readEngine(std::mt19937& engine) {
+    std::vector<char> text;
+    this->readVector(text);
+    std::istringstream state(std::string(text.begin(), text.end()));
+    if (!(state >> engine))
+        throw std::runtime_error("Invalid random engine state in " + this->path);
+}
+
+bool CheckpointReader::exists(const std::string& path) { return std::ifstream(path).good(); }
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->changed.notify_all();
+
+    if (this->worker.joinable())
+        this->worker.join();
+}
+
+/**
+ * @brief Queues a snapshot for writing and returns at once; the file is written by a background
+ * thread, started on the first call.
+ *
+ * Only the newest snapshot of each path is kept: one still waiting when the next arrives is
+ * replaced, so a slow disk delays checkpoints instead of stalling the search.
+ */
+
+void CheckpointWriter::submit(const std::string& path, std::vector<char>&& bytes) {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->pending[path] = std::move(bytes);
+
+        if (!this->worker.joinable())
+            this->worker = std::thread(&CheckpointWriter::workerLoop, this);
+    }
+    this->changed.notify_all();
+}
+
+/**
+ * @brief Blocks until every queued snapshot is on disk.
+ */
+
+void CheckpointWriter::flush() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->changed.wait(lock, [this]() { return this->pending.empty() && !this->writing; });
+}
+
+size_t CheckpointWriter::getNumberOfWrites() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->numberOfWrites;
+}
+
+/**
+ * @brief Writes the queued snapshots, each to a temporary file renamed over the previous
+ * checkpoint, so an interrupted write never leaves a truncated checkpoint behind. Pending
+ * snapshots are written before the thread exits.
+ */
+
+void CheckpointWriter::workerLoop() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while (true) {
+        this->changed.wait(lock, [this]() { return this->stopping || !this->pending.empty(); });
+
+        if (this->pending.empty())
+            return;
+
+        std::string path = this->pending.begin()->first;
+        std::vector<char> bytes = std::move(this->pending.begin()->second);
+        this->pending.erase(this->pending.begin());
+        this->writing = true;
+        lock.unlock();
+
+        std::string temporary = path + ".tmp";
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), bytes.size());
+        file.close();
+
+        bool written = file && (std::rename(temporary.c_str(), path.c_str()) == 0);
+        if (!written)
+            std::cerr << "Cannot write checkpoint " << path << std::endl;
+
+        lock.lock();
+        this->writing = false;
+        this->numberOfWrites += written ? 1 : 0;
+        this->changed.notify_all();
+    }
+}
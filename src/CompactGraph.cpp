@@ -0,0 +1,41 @@
+#include "CompactGraph.hpp"
+#include <limits>
+#include <stdexcept>
+
+/**
+ * @brief Packs the adjacency lists of a graph, in their order, into compressed sparse rows, and
+ * copies its vertex costs.
+ *
+ * @param graph The graph, with vertices 0 to order - 1; deleted vertices get empty rows.
+ * @throws std::length_error if the graph has too many vertices or edges for 32-bit ids and offsets.
+ */
+
+CompactGraph::CompactGraph(const Graph& graph)
+    : order(graph.getOrder()), isDirected(graph.isDirectedGraph()), outOffsets(graph.getOrder() + 1, 0),
+      inOffsets(graph.isDirectedGraph() ? graph.getOrder() + 1 : 0, 0), costs(graph.getOrder()) {
+    const size_t limit = std::numeric_limits<uint32_t>::max();
+
+    if ((this->order >= limit) || (graph.getSize() >= limit / 2))
+        throw std::length_error("Graph too large for 32-bit compact storage");
+
+    for (size_t i = 0; i < this->order; ++i)
+        this->costs[i] = graph.getCost(i);
+
+    auto pack = [&](std::vector<uint32_t>& offsets, std::vector<uint32_t>& targets, bool inNeighbors) {
+        for (size_t i = 0; i < this->order; ++i) {
+            if (graph.vertexExists(i)) {
+                const std::vector<size_t>& neighbors = inNeighbors ? graph.getInNeighbors(i) : graph.getAdjacencyList(i);
+                targets.insert(targets.end(), neighbors.begin(), neighbors.end());
+            }
+            offsets[i + 1] = targets.size();
+        }
+    };
+
+    this->outTargets.reserve(this->isDirected ? graph.getSize() : 2 * graph.getSize());
+    pack(this->outOffsets, this->outTargets, false);
+
+    if (this->isDirected) {
+        this->inTargets.reserve(graph.getSize());
+        pack(this->inOffsets, this->inTargets, true);
+    }
+}
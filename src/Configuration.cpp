@@ -0,0 +1,256 @@
+#include "Configuration.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos)
+        return "";
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+}
+
+/**
+ * @brief Reads the options of argv[first..argc): the file of `--config` first, then the flags.
+ *
+ * @throws std::invalid_argument for an argument that is not a `--key` flag.
+ * @throws std::runtime_error if the configuration file cannot be read.
+ */
+
+Configuration::Configuration(int argc, char** argv, int first) {
+    std::map<std::string, std::string> flags;
+
+    for (int i = first; i < argc; ++i) {
+        std::string argument = argv[i];
+        if ((argument.size() < 3) || (argument.compare(0, 2, "--") != 0))
+            throw std::invalid_argument("Expected an option --key, found " + argument);
+
+        size_t equals = argument.find('=');
+        std::string key = argument.substr(2, equals == std::string::npos ? std::string::npos : equals - 2);
+        if (equals != std::string::npos)
+            flags[key] = argument.substr(equals + 1);
+        else if ((i + 1 < argc) && (std::string(argv[i + 1]).compare(0, 2, "--") != 0))
+            flags[key] = argv[++i];
+        else
+            flags[key] = "true";
+    }
+
+    auto config = flags.find("config");
+    if (config != flags.end()) {
+        this->load(config->second);
+        flags.erase(config);
+    }
+
+    for (const auto& flag: flags)
+        this->values[flag.first] = flag.second;
+}
+
+/**
+ * @brief Reads `key = value` lines; blank lines and everything after a `#` are ignored.
+ */
+
+void Configuration::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file)
+        throw std::runtime_error("Cannot read configuration file " + path);
+
+    std::string line;
+    for (size_t number = 1; std::getline(file, line); ++number) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty())
+            continue;
+
+        size_t equals = line.find('=');
+        if ((equals == std::string::npos) || trim(line.substr(0, equals)).empty())
+            throw std::invalid_argument(path + ":" + std::to_string(number) + ": expected key = value");
+        this->values[trim(line.substr(0, equals))] = trim(line.substr(equals + 1));
+    }
+}
+
+const std::string* Configuration::find(const std::string& key) {
+    auto value = this->values.find(key);
+    if (value == this->values.end())
+        return nullptr;
+
+    this->used.insert(key);
+    return &value->second;
+}
+
+std::string Configuration::getString(const std::string& key, const std::string& value) {
+    const std::string* text = this->find(key);
+    return text ? *text : value;
+}
+
+/**
+ * @throws std::invalid_argument if the option is not an integer from `minimum` to `maximum`.
+ */
+
+size_t Configuration::getSize(const std::string& key, size_t value, size_t minimum, size_t maximum) {
+    const std::string* text = this->find(key);
+    if (!text)
+        return value;
+
+    size_t end = 0;
+    try {
+        if (text->find('-') == std::string::npos)
+            value = std::stoull(*text, &end);
+    } catch (const std::exception&) {}
+    if ((end == 0) || (end != text->size()))
+        throw std::invalid_argument("Option --" + key + " expects a non-negative integer, not " + *text);
+    if ((value < minimum) || (value > maximum))
+        throw std::invalid_argument("Option --" + key + " expects an integer from " + std::to_string(minimum) + " to "
+                                    + std::to_string(maximum) + ", not " + *text);
+
+    return value;
+}
+
+/**
+ * @throws std::invalid_argument if the option is not a number.
+ */
+
+double Configuration::getDouble(const std::string& key, double value) {
+    const std::string* text = this->find(key);
+    if (!text)
+        return value;
+
+    size_t end = 0;
+    try {
+        value = std::stod(*text, &end);
+    } catch (const std::exception&) {}
+    if ((end == 0) || (end != text->size()))
+        throw std::invalid_argument("Option --" + key + " expects a number, not " + *text);
+
+    return value;
+}
+
+/**
+ * @throws std::invalid_argument if the option is not true, false, 1 or 0.
+ */
+
+bool Configuration::getBool(const std::string& key, bool value) {
+    const std::string* text = this->find(key);
+    if (!text)
+        return value;
+
+    if ((*text == "true") || (*text == "1"))
+        return true;
+    if ((*text == "false") || (*text == "0"))
+        return false;
+    throw std::invalid_argument("Option --" + key + " expects true or false, not " + *text);
+}
+
+/**
+ * @brief Reads a comma-separated list.
+ */
+
+std::vector<std::string> Configuration::getList(const std::string& key, const std::vector<std::string>& value) {
+    const std::string* text = this->find(key);
+    if (!text)
+        return value;
+
+    std::vector<std::string> list;
+    std::stringstream stream(*text);
+    std::string item;
+    while (std::getline(stream, item, ','))
+        if (!item.empty())
+            list.push_back(item);
+
+    return list;
+}
+
+/**
+ * @brief Overrides the batch and engine parameters the options name; the others keep the values
+ * of `settings`. The time budget bounds each run of every engine, the tabu search included, and
+ * the RVNS time budget is in milliseconds. Integers narrowed to smaller types are range-checked
+ * here; the engine parameters are checked by BatchSolver::checkSettings before anything runs.
+ */
+
+void Configuration::apply(BatchSettings& settings) {
+    settings.input = this->getString("input", settings.input);
+    settings.output = this->getString("output", settings.output);
+    settings.algorithms = this->getList("algorithms", settings.algorithms);
+    settings.seeds = this->getSize("seeds", settings.seeds);
+    settings.firstSeed = static_cast<unsigned int>(this->getSize("seed", settings.firstSeed, 0,
+                                                                 std::numeric_limits<unsigned int>::max()));
+    if ((settings.seeds > 0) && (settings.seeds - 1 > std::numeric_limits<unsigned int>::max() - settings.firstSeed))
+        throw std::invalid_argument("The seeds from --seed on must fit in an unsigned int");
+    settings.numberOfThreads = this->getSize("threads", settings.numberOfThreads);
+    settings.timeBudget = this->getDouble("time-budget", settings.timeBudget);
+    settings.tabu.timeBudget = settings.timeBudget;
+    settings.directed = this->getBool("directed", settings.directed);
+    if (const std::string* ordering = this->find("ordering"))
+        settings.ordering = VertexOrdering::parse(*ordering);
+    if (const std::string* affinity = this->find("affinity"))
+        settings.affinity = Topology::parse(*affinity);
+    settings.replicateGraph = this->getBool("replicate-graph", settings.replicateGraph);
+    settings.smallGraphOrder = this->getSize("small-graph-order", settings.smallGraphOrder);
+    settings.largeGraphOrder = this->getSize("large-graph-order", settings.largeGraphOrder);
+    settings.largeGraphRVNSThreads = this->getSize("large-graph-rvns-threads", settings.largeGraphRVNSThreads);
+    settings.exactNodeLimit = this->getSize("exact-node-limit", settings.exactNodeLimit);
+
+    settings.populationSize = this->getSize("population", settings.populationSize, 2);
+    settings.generations = this->getSize("generations", settings.generations);
+    settings.heuristic = static_cast<short int>(this->getSize("heuristic", settings.heuristic, 1, 3));
+    GeneticOperators& operators = settings.operators;
+    operators.selection = this->getString("selection", operators.selection);
+    operators.crossover = this->getString("crossover", operators.crossover);
+    operators.backend = this->getString("backend", operators.backend);
+    operators.improvement = this->getString("improvement", operators.improvement);
+    operators.tournamentProbability = this->getDouble("tournament-probability", operators.tournamentProbability);
+
+    settings.numberOfAnts = this->getSize("ants", settings.numberOfAnts);
+    settings.iterations = this->getSize("iterations", settings.iterations);
+    settings.stopACO.maxNoImprovementIterations = this->getSize("no-improvement",
+                                                                settings.stopACO.maxNoImprovementIterations);
+    settings.stopACO.targetWeight = this->getSize("target-weight", settings.stopACO.targetWeight);
+    if (const std::string* policy = this->find("restart-policy"))
+        settings.restartACO.policy = ACORestartSettings::parse(*policy);
+    settings.restartACO.convergenceThreshold = this->getDouble("restart-threshold",
+                                                               settings.restartACO.convergenceThreshold);
+    settings.restartACO.noImprovementIterations = this->getSize("restart-no-improvement",
+                                                                settings.restartACO.noImprovementIterations);
+    settings.timeBudgetRVNS = this->getDouble("rvns-time-budget", settings.timeBudgetRVNS);
+    std::string improvementACO = this->getString("aco-improvement", settings.localSearchACO ? "local-search" : "none");
+    if ((improvementACO != "none") && (improvementACO != "local-search"))
+        throw std::invalid_argument("Unknown ACO improvement " + improvementACO);
+    settings.localSearchACO = improvementACO == "local-search";
+    ACOParameters& aco = settings.aco;
+    aco.evaporationRate = this->getDouble("evaporation-rate", aco.evaporationRate);
+    aco.minPheromone = this->getDouble("min-pheromone", aco.minPheromone);
+    aco.maxPheromone = this->getDouble("max-pheromone", aco.maxPheromone);
+    aco.minDestructionRate = this->getDouble("min-destruction-rate", aco.minDestructionRate);
+    aco.maxDestructionRate = this->getDouble("max-destruction-rate", aco.maxDestructionRate);
+    aco.maxRVNSfunctions = this->getSize("rvns-functions", aco.maxRVNSfunctions);
+    aco.maxRVNSiterations = this->getSize("rvns-iterations", aco.maxRVNSiterations);
+    aco.maxRVNSnoImprovementIterations = this->getSize("rvns-no-improvement", aco.maxRVNSnoImprovementIterations);
+    aco.addVerticesRate = this->getDouble("add-vertices-rate", aco.addVerticesRate);
+    aco.selectionVertexRateConstructSolution = this->getDouble("construct-selection-rate",
+                                                               aco.selectionVertexRateConstructSolution);
+    aco.selectionVertexRateExtendSolution = this->getDouble("extend-selection-rate",
+                                                            aco.selectionVertexRateExtendSolution);
+
+    TabuSettings& tabu = settings.tabu;
+    tabu.iterations = this->getSize("tabu-iterations", tabu.iterations);
+    tabu.stallIterations = this->getSize("tabu-stall", tabu.stallIterations);
+    tabu.tenure = this->getSize("tabu-tenure", tabu.tenure);
+    tabu.tenureRange = this->getSize("tabu-tenure-range", tabu.tenureRange);
+    tabu.penaltyPeriod = this->getSize("tabu-penalty-period", tabu.penaltyPeriod);
+}
+
+/**
+ * @throws std::invalid_argument naming the options that no getter read.
+ */
+
+void Configuration::checkUnused() const {
+    std::string unused;
+    for (const auto& value: this->values)
+        if (this->used.count(value.first) == 0)
+            unused += (unused.empty() ? "--" : ", --") + value.first;
+
+    if (!unused.empty())
+        throw std::invalid_argument("Unknown option " + unused);
+}
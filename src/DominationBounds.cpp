@@ -0,0 +1,119 @@
+#include "DominationBounds.hpp"
+#include <cmath>
+
+namespace {
+
+// Rounds a fractional bound up, forgiving the rounding error of summing fractions such as 3/7.
+size_t roundUp(double bound) { return static_cast<size_t>(std::ceil(bound - 1e-9)); }
+
+}
+
+/**
+ * @brief Least weight a vertex of the given degree pays per unit of coverage.
+ *
+ * A vertex covers itself by 1 when labeled 2 or 3 and by 1/2 when labeled 1; it covers each
+ * neighbor by 1 when labeled 3 and by 1/2 when labeled 2. A labeling is a double Roman dominating
+ * function exactly when every vertex is covered by at least 1 (a 0 next to a 3 or to two 2s, a 1
+ * next to a 2, or a vertex labeled 2 or 3), so its weight is at least the coverage it spreads times
+ * the cost of that coverage: min(3 / (d + 1), 4 / (d + 2), 2).
+ */
+
+double DominationBounds::coverageCost(size_t degree) {
+    return std::min({ 3.0 / (degree + 1), 4.0 / (degree + 2), 2.0 });
+}
+
+/**
+ * @brief Least weight a vertex pays per unit of coverage once its cost multiplies its labels:
+ * cost(v) · coverageCost(deg(v)).
+ */
+
+double DominationBounds::coverageCost(const Graph& graph, size_t vertex) {
+    return graph.getCost(vertex) * coverageCost(graph.getVertexDegree(vertex));
+}
+
+/**
+ * @brief Degree bound: every vertex needs a unit of coverage, bought at the cheapest coverage cost
+ * of the graph. With unit costs that is the cost of the vertex of maximum degree Δ, so
+ * γdR(G) ≥ ⌈n · min(3 / (Δ + 1), 4 / (Δ + 2), 2)⌉, i.e. ⌈3n / (Δ + 1)⌉ when Δ ≥ 2.
+ */
+
+size_t DominationBounds::degreeBound(const Graph& graph) {
+    double cheapest = 2.0;
+    bool found = false;
+
+    for (size_t i = 0; i < graph.getOrder(); ++i)
+        if (graph.vertexExists(i)) {
+            double cost = coverageCost(graph, i);
+            cheapest = found ? std::min(cheapest, cost) : cost;
+            found = true;
+        }
+
+    return roundUp(graph.getOrder() * cheapest);
+}
+
+/**
+ * @brief Fractional bound of a set of vertices: each pays for its unit of coverage at the cheapest
+ * cost in its closed neighborhood, which is a feasible solution of the dual of the LP relaxation.
+ * On a directed graph a vertex is covered by its in-neighbors, at a cost set by their out-degrees.
+ *
+ * @param graph The graph.
+ * @param vertices The vertices whose coverage is counted, e.g. those of a component.
+ * @return double A lower bound on the weight the labeling puts on the closed neighborhoods of `vertices`.
+ */
+
+double DominationBounds::fractionalBound(const Graph& graph, const std::vector<size_t>& vertices) {
+    double bound = 0.0;
+
+    for (const auto& vertex: vertices) {
+        double cost = coverageCost(graph, vertex);
+        for (const auto& neighbor: graph.getInNeighbors(vertex))
+            cost = std::min(cost, coverageCost(graph, neighbor));
+        bound += cost;
+    }
+
+    return bound;
+}
+
+/**
+ * @brief Best lower bound on γdR(G) available in linear time.
+ *
+ * Components are bounded separately, each by the larger of its rounded fractional bound and of the
+ * least weight of any component (2 for an isolated vertex, since it must dominate itself, and 3
+ * otherwise, both times the cheapest cost of the component), and the bounds are summed. Components of a directed graph are its weakly connected ones. The result never exceeds γdR(G), so a solution reaching
+ * it is optimal.
+ */
+
+size_t DominationBounds::lowerBound(const Graph& graph) {
+    size_t order = graph.getOrder();
+    std::vector<bool> visited(order, false);
+    size_t bound = 0;
+
+    for (size_t i = 0; i < order; ++i) {
+        if (visited[i] || !graph.vertexExists(i))
+            continue;
+
+        std::vector<size_t> component = { i };
+        visited[i] = true;
+
+        auto visit = [&](const std::vector<size_t>& neighbors) {
+            for (const auto& neighbor: neighbors)
+                if ((neighbor < order) && !visited[neighbor]) {
+                    visited[neighbor] = true;
+                    component.push_back(neighbor);
+                }
+        };
+
+        size_t cheapest = graph.getCost(i);
+
+        for (size_t head = 0; head < component.size(); ++head) {
+            visit(graph.getAdjacencyList(component[head]));
+            if (graph.isDirectedGraph())
+                visit(graph.getInNeighbors(component[head]));
+            cheapest = std::min(cheapest, graph.getCost(component[head]));
+        }
+
+        bound += std::max(roundUp(fractionalBound(graph, component)), (component.size() == 1 ? 2 : 3) * cheapest);
+    }
+
+    return std::max(bound, degreeBound(graph));
+}
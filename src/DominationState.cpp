@@ -0,0 +1,197 @@
+#include "DominationState.hpp"
+
+/**
+ * @brief Builds the domination counters of a labeling.
+ *
+ * For every vertex, the number of neighbors labeled 3 and labeled 2 is stored, so that
+ * the Double Roman Domination constraints of a vertex can be checked without visiting
+ * its neighborhood. A label weighs its value times the cost of its vertex; unlabeled vertices (-1)
+ * weigh nothing and are never dominated by themselves.
+ *
+ * @param graph The graph the labeling refers to. It must outlive the state.
+ * @param labels The labeling, one entry per vertex.
+ */
+
+DominationState::DominationState(const Graph& graph, const std::vector<int>& labels)
+    : graph(&graph), labels(labels), neighborsLabeled3(labels.size(), 0),
+      neighborsLabeled2(labels.size(), 0), weight(0) {
+
+    for (size_t i = 0; i < this->labels.size(); ++i) {
+        if (this->labels[i] > 0)
+            this->weight += this->labels[i] * graph.getCost(i);
+
+        if (this->labels[i] == 3 || this->labels[i] == 2) {
+            for (const auto& neighbor: graph.getAdjacencyList(i)) {
+                if (this->labels[i] == 3)
+                    ++this->neighborsLabeled3[neighbor];
+                else
+                    ++this->neighborsLabeled2[neighbor];
+            }
+        }
+    }
+}
+
+int DominationState::getLabel(size_t vertex) const { return this->labels[vertex]; }
+
+size_t DominationState::getWeight() const { return this->weight; }
+
+const std::vector<int>& DominationState::getLabels() const { return this->labels; }
+
+/**
+ * @brief Checks the DRDF constraint of a single vertex from its counters.
+ *
+ * A vertex labeled 0 (or unlabeled) needs a neighbor labeled 3 or two neighbors labeled 2;
+ * a vertex labeled 1 needs a neighbor labeled 2 or 3; labels 2 and 3 dominate themselves.
+ */
+
+bool DominationState::dominated(int label, size_t labeled3, size_t labeled2) {
+    if (label >= 2)
+        return true;
+    if (label == 1)
+        return (labeled3 + labeled2) > 0;
+    return (labeled3 > 0) || (labeled2 > 1);
+}
+
+/**
+ * @brief Changes the label of a vertex, updating the weight in O(1) and the counters of its
+ * neighbors in O(deg).
+ *
+ * @param vertex The vertex to relabel.
+ * @param label The new label (-1 to unlabel it).
+ */
+
+void DominationState::setLabel(size_t vertex, int label) {
+    int oldLabel = this->labels[vertex];
+
+    if (oldLabel == label)
+        return;
+
+    size_t cost = this->graph->getCost(vertex);
+
+    if (oldLabel > 0)
+        this->weight -= oldLabel * cost;
+    if (label > 0)
+        this->weight += label * cost;
+
+    for (const auto& neighbor: this->graph->getAdjacencyList(vertex)) {
+        if (oldLabel == 3)
+            --this->neighborsLabeled3[neighbor];
+        else if (oldLabel == 2)
+            --this->neighborsLabeled2[neighbor];
+
+        if (label == 3)
+            ++this->neighborsLabeled3[neighbor];
+        else if (label == 2)
+            ++this->neighborsLabeled2[neighbor];
+    }
+
+    this->labels[vertex] = label;
+}
+
+/**
+ * @brief Updates the counters after the graph gained the edge {source, destination}, or the arc
+ * (source, destination) on a directed graph, in O(1); the labels and the weight are unchanged.
+ */
+
+void DominationState::edgeAdded(size_t source, size_t destination) {
+    this->countArc(source, destination, true);
+    if (!this->graph->isDirectedGraph())
+        this->countArc(destination, source, true);
+}
+
+/**
+ * @brief Updates the counters after the graph lost the edge {source, destination}, or the arc
+ * (source, destination) on a directed graph, in O(1). The endpoints it dominated may no longer be.
+ */
+
+void DominationState::edgeRemoved(size_t source, size_t destination) {
+    this->countArc(source, destination, false);
+    if (!this->graph->isDirectedGraph())
+        this->countArc(destination, source, false);
+}
+
+void DominationState::countArc(size_t source, size_t destination, bool added) {
+    int label = this->labels[source];
+    if ((label != 3) && (label != 2))
+        return;
+
+    size_t& counter = label == 3 ? this->neighborsLabeled3[destination] : this->neighborsLabeled2[destination];
+    if (added)
+        ++counter;
+    else
+        --counter;
+}
+
+bool DominationState::isDominated(size_t vertex) const {
+    return dominated(this->labels[vertex], this->neighborsLabeled3[vertex], this->neighborsLabeled2[vertex]);
+}
+
+/**
+ * @brief Checks whether a vertex can take a new label while the labeling stays a DRDF
+ * on its closed neighborhood.
+ *
+ * Only the vertex and its neighbors are inspected, so the check costs O(deg).
+ *
+ * @param vertex The vertex to relabel.
+ * @param label The candidate label.
+ * @return true if the vertex and all its neighbors would remain dominated.
+ */
+
+bool DominationState::canRelabel(size_t vertex, int label) const {
+    int oldLabel = this->labels[vertex];
+
+    if (!dominated(label, this->neighborsLabeled3[vertex], this->neighborsLabeled2[vertex]))
+        return false;
+
+    int lost3 = (oldLabel == 3) - (label == 3);
+    int lost2 = (oldLabel == 2) - (label == 2);
+
+    if (lost3 <= 0 && lost2 <= 0)
+        return true;
+
+    for (const auto& neighbor: this->graph->getAdjacencyList(vertex)) {
+        if (!dominated(this->labels[neighbor],
+                this->neighborsLabeled3[neighbor] - lost3,
+                this->neighborsLabeled2[neighbor] - lost2))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Change in the number of undominated vertices if a vertex took a new label, checked on its
+ * closed neighborhood in O(deg); negative when the relabel dominates more vertices.
+ */
+
+int DominationState::undominatedDelta(size_t vertex, int label) const {
+    int delta = this->undominatedDeltaAt(vertex, vertex, label);
+    int oldLabel = this->labels[vertex];
+
+    if (((oldLabel == 3) == (label == 3)) && ((oldLabel == 2) == (label == 2)))
+        return delta;
+
+    for (const auto& neighbor: this->graph->getAdjacencyList(vertex))
+        delta += this->undominatedDeltaAt(neighbor, vertex, label);
+
+    return delta;
+}
+
+/**
+ * @brief Part of undominatedDelta() seen by one vertex: 1 if `observer` would lose its domination
+ * when `vertex` took the label, -1 if it would gain it, 0 otherwise. `observer` must be `vertex`
+ * or one of its neighbors (out-neighbors on a directed graph). O(1).
+ */
+
+int DominationState::undominatedDeltaAt(size_t observer, size_t vertex, int label) const {
+    size_t labeled3 = this->neighborsLabeled3[observer];
+    size_t labeled2 = this->neighborsLabeled2[observer];
+    bool before = dominated(this->labels[observer], labeled3, labeled2);
+
+    if (observer == vertex)
+        return before - dominated(label, labeled3, labeled2);
+
+    int oldLabel = this->labels[vertex];
+    return before - dominated(this->labels[observer], labeled3 + (label == 3) - (oldLabel == 3),
+                              labeled2 + (label == 2) - (oldLabel == 2));
+}
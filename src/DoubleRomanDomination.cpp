@@ -1,17 +1,12 @@
 #include "DoubleRomanDomination.hpp"
+#include "Random.hpp"
+#include "Topology.hpp"
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <thread>
 
 
-/**
- * @brief Destructor for the DoubleRomanDomination class.
- * 
- * Frees the memory allocated for the genetic algorithm and graph objects.
- */
- 
-DoubleRomanDomination::~DoubleRomanDomination() {
-    delete this->geneticAlgorithm;
-    delete this->ACO;
-}
-
 /**
  * @brief Gets the graph used in the double Roman domination algorithm.
  * 
@@ -62,49 +57,178 @@ size_t DoubleRomanDomination::getGamma2rACO() {
     return this->gamma2rACO;
 }
 
+/**
+ * @brief Retrieves the lower bound on gamma2R computed before the algorithms run.
+ * 
+ * Both algorithms stop as soon as their best solution reaches it, and a gamma2R equal to it is optimal.
+ * 
+ * @return size_t The lower bound of DominationBounds::lowerBound.
+ */
+ 
+size_t DoubleRomanDomination::getLowerBound() {
+    return this->lowerBound;
+}
+
+/**
+ * @brief Retrieves the wall time of the last genetic algorithm run, in milliseconds.
+ */
+
+double DoubleRomanDomination::getMillisecondsGeneticAlgorithm() {
+    return this->millisecondsGeneticAlgorithm;
+}
+
+/**
+ * @brief Retrieves the wall time of the last ACO run, in milliseconds.
+ */
+
+double DoubleRomanDomination::getMillisecondsACO() {
+    return this->millisecondsACO;
+}
+
+/**
+ * @brief Retrieves the RVNS statistics gathered while running the ACO algorithm.
+ * 
+ * @return const RVNSStatistics& Calls, iterations, improvements and elapsed time of RVNS.
+ */
+ 
+const RVNSStatistics& DoubleRomanDomination::getRVNSStatisticsACO() {
+    return this->ACO->getRVNSStatistics();
+}
+
 /**
  * @brief Runs the genetic algorithm to compute the double Roman domination number (gamma2R).
  * 
- * Executes the genetic algorithm using a specified heuristic function and computes the sum of genes 
- * in the best chromosome solution, storing it as gamma2R.
+ * Executes the genetic algorithm, with the operators given to the constructor and the population
+ * created by the selected heuristic, and computes the weight
+ * of the best chromosome solution, storing it as gamma2R.
  * 
  * @param heuristic The heuristic identifier (1, 2, or 3) to select the appropriate heuristic function.
  */
  
 void DoubleRomanDomination::runGeneticAlgorithm(short int heuristic) {    
-                                                                                                                                       
-    Chromosome (*selectedHeuristic)(Graph) = nullptr;
-
-    if (heuristic == 2) 
-    	selectedHeuristic = heuristic2;
-    else if (heuristic == 3) 
-        selectedHeuristic = heuristic3;
-    else 
-        selectedHeuristic = heuristic1;
+    GeneticOperators operators = this->geneticAlgorithm->getOperators();
+    operators.heuristic = (heuristic == 2) || (heuristic == 3) ? heuristic : 1;
+    this->geneticAlgorithm->setOperators(operators);
 
-    this->geneticAlgorithm->run(geneticAlgorithm->getGenerations(), selectedHeuristic);
+    auto start = std::chrono::steady_clock::now();
+    this->geneticAlgorithm->run(geneticAlgorithm->getGenerations());
+    this->millisecondsGeneticAlgorithm = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 
     solutionGeneticAlgorithm = this->geneticAlgorithm->getBestSolution();
-    std::for_each(solutionGeneticAlgorithm.begin(), solutionGeneticAlgorithm.end(), [&](int element) {
-        this->gamma2rGeneticAlgorithm += element;
-    });
+    this->gamma2rGeneticAlgorithm = this->graph.getWeight(solutionGeneticAlgorithm);
 }
 
 
 /**
  * @brief Runs the ACO algorithm to compute the double Roman domination number (gamma2R).
  * 
- * Executes the ACO algorithm and computes the sum of genes in the best solution, storing it as gamma2R.
+ * Executes the ACO algorithm and computes the weight of the best solution, storing it as gamma2R.
  */
  
 void DoubleRomanDomination::runACO() {
+   auto start = std::chrono::steady_clock::now();
    this->ACO->run();
+   this->millisecondsACO = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
    
    solutionACO = this->ACO->getBestSolution();
+   this->gamma2rACO = this->graph.getWeight(solutionACO);
+}
+
+/**
+ * @brief Enables checkpointing of both algorithms, to `<path>.ga` and `<path>.aco`, and resumes
+ * each from its file when asked to and the file exists.
+ *
+ * In sequential mode the GA's final checkpoint records the random engine it leaves to the ACO, so
+ * an interrupted run resumed from either file goes on exactly as it would have.
+ *
+ * @param checkpoint Path prefix, interval and resume flag; an empty path disables checkpointing.
+ */
+
+void DoubleRomanDomination::setCheckpoint(const CheckpointSettings& checkpoint) {
+    if (checkpoint.path.empty())
+        return;
+
+    std::string geneticAlgorithmPath = checkpoint.path + ".ga";
+    std::string ACOPath = checkpoint.path + ".aco";
+
+    this->geneticAlgorithm->setCheckpoint(&this->checkpointWriter, geneticAlgorithmPath, checkpoint.interval);
+    this->ACO->setCheckpoint(&this->checkpointWriter, ACOPath, checkpoint.interval);
+
+    if (checkpoint.resume && CheckpointReader::exists(geneticAlgorithmPath))
+        this->geneticAlgorithm->resume(geneticAlgorithmPath);
+    if (checkpoint.resume && CheckpointReader::exists(ACOPath))
+        this->ACO->resume(ACOPath);
+}
+
+/**
+ * @brief Sets the stop criteria of the ACO and limits the wall time of each algorithm's run, in
+ * seconds; a positive `timeBudget` replaces the ACO's own budget, and 0 leaves the GA unlimited.
+ */
+
+void DoubleRomanDomination::setLimits(double timeBudget, ACOStopCriteria stopCriteriaACO) {
+    if (timeBudget > 0.0)
+        stopCriteriaACO.timeBudget = timeBudget;
+
+    this->geneticAlgorithm->setTimeBudget(timeBudget);
+    this->ACO->setStopCriteria(stopCriteriaACO);
+}
+
+/**
+ * @brief Runs the genetic algorithm and the ACO at the same time, sharing their incumbents.
+ *
+ * The genetic algorithm runs on its own thread and the ACO on the calling one; both publish their
+ * best solutions to a SharedIncumbent. ACO bests are injected into the GA population and GA bests
+ * become the ACO's best-so-far solution, which drives its pheromone update. The wall time is that
+ * of the slower algorithm, and each gamma2R is that of the solution its algorithm ends with. When
+ * the calling thread is bound to a NUMA node, the GA thread binds to the same node, so its
+ * population is allocated there. The GA thread is always joined: if the ACO throws, the GA is
+ * cancelled and the exception propagates, and an exception thrown on the GA thread is rethrown
+ * here once the ACO is done.
+ *
+ * @param heuristic The heuristic identifier (1, 2, or 3) creating the GA population.
+ */
+
+void DoubleRomanDomination::runHybrid(short int heuristic) {
+    SharedIncumbent sharedIncumbent;
+
+    std::atomic<bool> cancelled(false);
+    std::exception_ptr geneticAlgorithmError;
+
+    this->geneticAlgorithm->setSharedIncumbent(&sharedIncumbent);
+    this->ACO->setSharedIncumbent(&sharedIncumbent);
+    this->geneticAlgorithm->setCancellationFlag(&cancelled);
+
+    auto detach = [this]() {
+        this->geneticAlgorithm->setSharedIncumbent(nullptr);
+        this->ACO->setSharedIncumbent(nullptr);
+        this->geneticAlgorithm->setCancellationFlag(nullptr);
+    };
+
+    size_t node = Topology::getBoundNode();
+    std::thread geneticAlgorithmThread([this, heuristic, node, &geneticAlgorithmError]() {
+        try {
+            if (node != Topology::none)
+                Topology::bindToNode(node);
+            this->runGeneticAlgorithm(heuristic);
+        } catch (...) {
+            geneticAlgorithmError = std::current_exception();
+        }
+    });
+
+    try {
+        this->runACO();
+    } catch (...) {
+        cancelled = true;
+        geneticAlgorithmThread.join();
+        detach();
+        throw;
+    }
+
+    geneticAlgorithmThread.join();
+    detach();
 
-   std::for_each(solutionACO.begin(), solutionACO.end(), [&](int element) {
-      this->gamma2rACO += element;
-   });
+    if (geneticAlgorithmError)
+        std::rethrow_exception(geneticAlgorithmError);
 }
 
 /**
@@ -119,8 +243,7 @@ void DoubleRomanDomination::runACO() {
  
 Chromosome DoubleRomanDomination::heuristic1(Graph graph) {
     Chromosome solution(Chromosome(graph.getOrder()));
-    std::random_device randomNumber;
-    std::mt19937 seed(randomNumber());
+    std::mt19937& seed = Random::engine();
     std::uniform_int_distribution<int> gap(0, graph.getOrder() - 1);
 	
     size_t choosenVertex = 0;
@@ -139,7 +262,7 @@ Chromosome DoubleRomanDomination::heuristic1(Graph graph) {
         graph.deleteAdjacencyList(choosenVertex);
 
         if (graph.getOrder() == 1) {
-            choosenVertex = graph.getAdjacencyList().begin()->first;
+            choosenVertex = graph.getVertices().front();
             solution.genes[choosenVertex] = 3;
             graph.deleteVertex(choosenVertex);
         }
@@ -160,8 +283,7 @@ Chromosome DoubleRomanDomination::heuristic1(Graph graph) {
  
 Chromosome DoubleRomanDomination::heuristic2(Graph graph) {
     Chromosome solution(Chromosome(graph.getOrder()));
-    std::random_device randomNumber;
-    std::mt19937 seed(randomNumber());
+    std::mt19937& seed = Random::engine();
     std::uniform_int_distribution<int> gap(0, graph.getOrder() - 1);
     
     size_t choosenVertex = 0;
@@ -196,8 +318,9 @@ Chromosome DoubleRomanDomination::heuristic2(Graph graph) {
 /**
  * @brief Generates an initial chromosome solution for double Roman domination using heuristic 3.
  * 
- * This heuristic sorts vertices by degree in descending order, selects the highest degree vertices, 
- * and assigns values while updating their neighbors.
+ * This heuristic sorts vertices by closed-neighborhood size per unit of vertex cost (the degree on
+ * unit-cost graphs) in descending order, selects the first vertices, and assigns values while
+ * updating their neighbors.
  * 
  * @param graph Graph object used to create the chromosome.
  * @return Chromosome The generated chromosome solution.
@@ -213,7 +336,7 @@ Chromosome DoubleRomanDomination::heuristic3(Graph graph) {
 
     std::sort(sortedVertices.begin(), sortedVertices.end(),
         [&](size_t a, size_t b) {
-            return graph.getVertexDegree(a) > graph.getVertexDegree(b);
+            return (graph.getVertexDegree(a) + 1) * graph.getCost(b) > (graph.getVertexDegree(b) + 1) * graph.getCost(a);
     });
 
     size_t choosenVertex = 0;
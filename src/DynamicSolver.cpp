@@ -0,0 +1,337 @@
+#include "DynamicSolver.hpp"
+#include "DominationBounds.hpp"
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+const std::vector<int>& checkLabels(const Graph& graph, const std::vector<int>& solution) {
+    if (solution.size() != graph.getOrder())
+        throw std::invalid_argument("Expected one label per vertex");
+    for (const auto& label: solution)
+        if ((label < 0) || (label > 3))
+            throw std::invalid_argument("Labels must be 0, 1, 2 or 3");
+    return solution;
+}
+
+}
+
+/**
+ * @brief Solves a graph from scratch, with the GA and then the ACO as in the sequential mode of
+ * DoubleRomanDomination, and keeps both algorithms for the updates that follow.
+ *
+ * @param graph The initial graph; the solver works on its own copy.
+ * @param settings Budgets of the initial solve and of every update, and the GA operators.
+ */
+
+DynamicSolver::DynamicSolver(const Graph& graph, const DynamicSettings& settings)
+    : DynamicSolver(graph, std::vector<int>(graph.getOrder(), 2), settings) {
+    auto start = Clock::now();
+    this->search(this->settings.generations, this->settings.iterations, false);
+    this->statistics.searchMilliseconds = millisecondsSince(start);
+    this->statistics.weight = this->state.getWeight();
+}
+
+/**
+ * @brief Starts from a known solution of the graph, e.g. the one of a previous solve, without
+ * searching. Vertices it leaves undominated are repaired as in update().
+ *
+ * @param graph The initial graph; the solver works on its own copy.
+ * @param solution One label from 0 to 3 per vertex.
+ * @param settings Budgets of every update and the GA operators.
+ * @throws std::invalid_argument if the solution does not have one valid label per vertex.
+ */
+
+DynamicSolver::DynamicSolver(const Graph& graph, const std::vector<int>& solution, const DynamicSettings& settings)
+    : settings(settings), graph(graph), state(this->graph, checkLabels(graph, solution)),
+      geneticAlgorithm(this->graph, settings.populationSize, graph.getOrder(), settings.generations),
+      ACO(this->graph, settings.iterations, settings.numberOfAnts) {
+    GeneticOperators operators = settings.operators;
+    operators.heuristic = (settings.heuristic == 2) || (settings.heuristic == 3) ? settings.heuristic : 1;
+    this->geneticAlgorithm.setOperators(operators);
+
+    std::vector<size_t> raised;
+    for (size_t i = 0; i < this->graph.getOrder(); ++i)
+        this->statistics.repairedVertices += this->repair(i, raised) ? 1 : 0;
+
+    this->statistics.repairedWeight = this->state.getWeight();
+    this->statistics.weight = this->state.getWeight();
+}
+
+/**
+ * @brief Applies a batch of edge changes and re-optimizes the solution around them.
+ *
+ * The domination counters follow each change in O(1). Only the endpoints of the changes can lose
+ * their domination, when an edge to a neighbor labeled 2 or 3 goes away, so only they are
+ * repaired, each by the cheapest raise of its own label or of an in-neighbor's that dominates it
+ * again. Then the labels of the endpoints, of their neighbors and of the neighbors of the raised
+ * vertices are lowered wherever the closed neighborhood stays dominated, which also collects what
+ * added edges make redundant. Up to this point the work is proportional to the neighborhoods of
+ * the changes, not to the graph.
+ *
+ * With update budgets, the GA and then the ACO continue from the repaired solution: the GA from its
+ * last population, repaired for the new graph, and the ACO from its last pheromones, for
+ * `updateGenerations` generations and `updateIterations` iterations. Either is skipped once the
+ * solution reaches the lower bound of the new graph.
+ *
+ * @param deltas The changes, applied in order; adding an existing edge or removing a missing one
+ *        does nothing.
+ * @return size_t The weight of the new solution.
+ * @throws std::out_of_range if a change names a vertex outside the graph; no change is applied then.
+ */
+
+size_t DynamicSolver::update(const std::vector<EdgeDelta>& deltas) {
+    auto start = Clock::now();
+    size_t order = this->graph.getOrder();
+    this->statistics = UpdateStatistics();
+
+    for (const auto& delta: deltas)
+        if ((delta.source >= order) || (delta.destination >= order))
+            throw std::out_of_range("Edge change (" + std::to_string(delta.source) + ", " +
+                                    std::to_string(delta.destination) + ") has an endpoint outside the graph");
+
+    std::vector<size_t> affected;
+
+    for (const auto& delta: deltas) {
+        if (delta.added && this->graph.addEdge(delta.source, delta.destination)) {
+            this->state.edgeAdded(delta.source, delta.destination);
+            ++this->statistics.addedEdges;
+        } else if (!delta.added && this->graph.removeEdge(delta.source, delta.destination)) {
+            this->state.edgeRemoved(delta.source, delta.destination);
+            ++this->statistics.removedEdges;
+        } else
+            continue;
+
+        affected.push_back(delta.source);
+        affected.push_back(delta.destination);
+    }
+
+    std::sort(affected.begin(), affected.end());
+    affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+    this->statistics.affectedVertices = affected.size();
+
+    std::vector<size_t> raised;
+    for (const auto& vertex: affected)
+        this->statistics.repairedVertices += this->repair(vertex, raised) ? 1 : 0;
+
+    std::vector<size_t> candidates(affected);
+    for (const auto& vertex: affected) {
+        const std::vector<size_t>& outNeighbors = this->graph.getAdjacencyList(vertex);
+        candidates.insert(candidates.end(), outNeighbors.begin(), outNeighbors.end());
+        if (this->graph.isDirectedGraph()) {
+            const std::vector<size_t>& inNeighbors = this->graph.getInNeighbors(vertex);
+            candidates.insert(candidates.end(), inNeighbors.begin(), inNeighbors.end());
+        }
+    }
+    for (const auto& vertex: raised) {
+        const std::vector<size_t>& outNeighbors = this->graph.getAdjacencyList(vertex);
+        candidates.insert(candidates.end(), outNeighbors.begin(), outNeighbors.end());
+    }
+
+    this->reduce(candidates);
+
+    this->statistics.repairedWeight = this->state.getWeight();
+    this->statistics.repairMilliseconds = millisecondsSince(start);
+
+    start = Clock::now();
+    this->search(this->settings.updateGenerations, this->settings.updateIterations, true);
+    this->statistics.searchMilliseconds = millisecondsSince(start);
+    this->statistics.weight = this->state.getWeight();
+
+    return this->statistics.weight;
+}
+
+/**
+ * @brief Dominates an undominated vertex again by the cheapest single raise: the vertex to 1 or 2,
+ * or one of its in-neighbors to 2 or 3. Raising a label never undominates another vertex.
+ *
+ * @param vertex The vertex to repair; nothing is done if it is dominated.
+ * @param raised Receives the vertex whose label was raised.
+ * @return bool Whether a label was raised.
+ */
+
+bool DynamicSolver::repair(size_t vertex, std::vector<size_t>& raised) {
+    if (this->state.isDominated(vertex))
+        return false;
+
+    std::vector<std::pair<size_t, int>> moves;
+    for (const auto& neighbor: this->graph.getInNeighbors(vertex))
+        moves.push_back({ neighbor, 3 });
+    moves.push_back({ vertex, 2 });
+    moves.push_back({ vertex, 1 });
+    for (const auto& neighbor: this->graph.getInNeighbors(vertex))
+        moves.push_back({ neighbor, 2 });
+
+    std::pair<size_t, int> best = { vertex, 2 };
+    size_t bestCost = std::numeric_limits<size_t>::max();
+
+    for (const auto& move: moves) {
+        int label = this->state.getLabel(move.first);
+        if (move.second <= label)
+            continue;
+
+        size_t cost = (move.second - std::max(label, 0)) * this->graph.getCost(move.first);
+        if (cost >= bestCost)
+            continue;
+
+        this->state.setLabel(move.first, move.second);
+        bool dominated = this->state.isDominated(vertex);
+        this->state.setLabel(move.first, label);
+
+        if (dominated) {
+            best = move;
+            bestCost = cost;
+        }
+    }
+
+    this->state.setLabel(best.first, best.second);
+    raised.push_back(best.first);
+    return true;
+}
+
+/**
+ * @brief Lowers each candidate's label to the least one that keeps its closed neighborhood
+ * dominated, the vertices of least degree per unit of cost first, as ACO's reduceSolution does.
+ *
+ * @param candidates The vertices to try, in any order and possibly repeated.
+ */
+
+void DynamicSolver::reduce(std::vector<size_t>& candidates) {
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    std::stable_sort(candidates.begin(), candidates.end(), [this](size_t a, size_t b) {
+        return this->graph.getVertexDegree(a) * this->graph.getCost(b) <
+               this->graph.getVertexDegree(b) * this->graph.getCost(a);
+    });
+
+    for (const auto& vertex: candidates)
+        for (int label = 0; label < this->state.getLabel(vertex); ++label)
+            if (this->state.canRelabel(vertex, label)) {
+                this->state.setLabel(vertex, label);
+                break;
+            }
+}
+
+/**
+ * @brief Runs the GA and then the ACO on the current graph, each from the lightest solution so
+ * far when `warm`, and adopts the lightest result.
+ *
+ * @param generations Generations of the GA; 0 skips it.
+ * @param iterations Iterations of the ACO; 0 skips it.
+ * @param warm Whether to continue from the previous population and pheromones, otherwise the GA
+ *        creates a new population and the ACO starts from uniform pheromones.
+ */
+
+void DynamicSolver::search(size_t generations, size_t iterations, bool warm) {
+    if ((generations == 0) && (iterations == 0))
+        return;
+
+    size_t lowerBound = DominationBounds::lowerBound(this->graph);
+    std::vector<int> best = this->state.getLabels();
+    size_t bestWeight = this->state.getWeight();
+
+    auto consider = [this, &best, &bestWeight](const std::vector<int>& solution) {
+        size_t weight = this->graph.getWeight(solution);
+        if (weight < bestWeight) {
+            best = solution;
+            bestWeight = weight;
+        }
+    };
+
+    if ((generations > 0) && (bestWeight > lowerBound)) {
+        this->geneticAlgorithm.setLowerBound(lowerBound);
+        if (warm)
+            this->geneticAlgorithm.warmStart(this->graph, best);
+        this->geneticAlgorithm.run(generations);
+        consider(this->geneticAlgorithm.getBestSolution());
+    }
+
+    if ((iterations > 0) && (bestWeight > lowerBound)) {
+        this->ACO.setLowerBound(lowerBound);
+        this->ACO.setIterations(iterations);
+        if (warm)
+            this->ACO.warmStart(this->graph, best);
+        this->ACO.run();
+        consider(this->ACO.getBestSolution());
+    }
+
+    this->adopt(best);
+}
+
+/**
+ * @brief Makes `solution` the current one, relabeling only the vertices whose label differs.
+ */
+
+void DynamicSolver::adopt(const std::vector<int>& solution) {
+    for (size_t i = 0; i < solution.size(); ++i)
+        this->state.setLabel(i, solution[i]);
+}
+
+const Graph& DynamicSolver::getGraph() const { return this->graph; }
+
+const std::vector<int>& DynamicSolver::getSolution() const { return this->state.getLabels(); }
+
+size_t DynamicSolver::getWeight() const { return this->state.getWeight(); }
+
+/**
+ * @brief Statistics of the last update, or of the initial solve before any update.
+ */
+
+const UpdateStatistics& DynamicSolver::getStatistics() const { return this->statistics; }
+
+/**
+ * @brief Reads a stream of edge changes: one "+ u v" (add) or "- u v" (remove) per line, in
+ * batches separated by blank lines. Lines starting with '#' are comments.
+ *
+ * @return std::vector<std::vector<EdgeDelta>> The non-empty batches, in file order.
+ * @throws std::runtime_error if the file cannot be opened or a line is not a change.
+ */
+
+std::vector<std::vector<EdgeDelta>> DynamicSolver::readDeltas(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file)
+        throw std::runtime_error("Cannot open " + filename);
+
+    std::vector<std::vector<EdgeDelta>> batches(1);
+    std::string line;
+    size_t number = 0;
+
+    while (std::getline(file, line)) {
+        ++number;
+        std::stringstream fields(line);
+        std::string sign;
+
+        if (!(fields >> sign)) {
+            if (!batches.back().empty())
+                batches.emplace_back();
+            continue;
+        }
+
+        if (sign[0] == '#')
+            continue;
+
+        EdgeDelta delta;
+        std::string rest;
+        if (((sign != "+") && (sign != "-")) || !(fields >> delta.source >> delta.destination) || (fields >> rest))
+            throw std::runtime_error("Expected \"+ u v\" or \"- u v\" at line " + std::to_string(number) +
+                                     " of " + filename);
+
+        delta.added = sign == "+";
+        batches.back().push_back(delta);
+    }
+
+    if (batches.back().empty())
+        batches.pop_back();
+
+    return batches;
+}
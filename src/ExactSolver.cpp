@@ -0,0 +1,323 @@
+#include "ExactSolver.hpp"
+#include "DominationBounds.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// Coverage of a vertex by its own label and by the label of a neighbor (see DominationBounds).
+const double selfCoverage[4] = { 0.0, 0.5, 1.0, 1.0 };
+const double neighborCoverage[4] = { 0.0, 0.0, 0.5, 1.0 };
+
+size_t popcount(uint64_t mask) { return __builtin_popcountll(mask); }
+
+}
+
+/**
+ * @brief Prepares the exact search of a graph of at most 64 vertices, whose neighborhoods are
+ * stored as 64-bit masks. Labels weigh their value times the cost of their vertex.
+ *
+ * @param graph The graph, with vertices 0 to order - 1.
+ * @param maxNodes Search nodes after which the search gives up, returning the best solution found
+ *        and the root lower bound; 0 searches to the end.
+ * @throws std::invalid_argument if the graph has more than `maxOrder` vertices or is directed.
+ */
+
+ExactSolver::ExactSolver(const Graph& graph, size_t maxNodes)
+    : order(graph.getOrder()), neighborhoods(graph.getOrder(), 0), degrees(graph.getOrder(), 0),
+      costs(graph.getOrder(), 1), rootBound(0), maxNodes(maxNodes), nodes(0), aborted(false),
+      labels(graph.getOrder(), 0), caps(graph.getOrder(), 3), labeled3(0), labeled2(0),
+      bestSolution(graph.getOrder(), 2), bestWeight(0) {
+    if (this->order > maxOrder)
+        throw std::invalid_argument("The exact solver handles at most 64 vertices");
+    if (graph.isDirectedGraph())
+        throw std::invalid_argument("The exact solver needs an undirected graph");
+
+    for (size_t i = 0; i < this->order; ++i) {
+        if (!graph.vertexExists(i))
+            continue;
+
+        for (const auto& j: graph.getAdjacencyList(i)) {
+            if ((j == i) || (j >= this->order))
+                continue;
+            this->neighborhoods[i] |= uint64_t(1) << j;
+            this->neighborhoods[j] |= uint64_t(1) << i;
+        }
+    }
+
+    for (size_t i = 0; i < this->order; ++i) {
+        this->degrees[i] = popcount(this->neighborhoods[i]);
+        this->costs[i] = graph.getCost(i);
+        this->bestWeight += 2 * this->costs[i];
+    }
+
+    this->rootBound = DominationBounds::lowerBound(graph);
+}
+
+/**
+ * @brief Starts the search from a known solution, e.g. a metaheuristic's, so that only lighter
+ * ones are explored; ignored unless it is a lighter double Roman dominating function.
+ */
+
+void ExactSolver::setUpperBound(const std::vector<int>& solution) {
+    if (solution.size() != this->order)
+        return;
+
+    size_t weight = 0;
+    bool valid = true;
+
+    for (size_t i = 0; i < this->order; ++i) {
+        valid = valid && (solution[i] >= 0) && (solution[i] <= 3);
+        weight += valid ? solution[i] * this->costs[i] : 0;
+        this->setLabel(i, valid ? solution[i] : 0);
+    }
+
+    for (size_t i = 0; valid && (i < this->order); ++i)
+        valid = this->isDominated(i);
+
+    for (size_t i = 0; i < this->order; ++i)
+        this->setLabel(i, 0);
+
+    if (valid && (weight < this->bestWeight)) {
+        this->bestSolution = solution;
+        this->bestWeight = weight;
+    }
+}
+
+/**
+ * @brief Searches for a minimum double Roman dominating function by branch and bound.
+ *
+ * A search node is a partial labeling that only ever raises labels, with a cap per vertex. The
+ * node branches on the undominated vertex v with the fewest options, which are the ways any
+ * solution dominates v: a neighbor raised to 3, v raised to 2, a neighbor raised to 2, or v raised
+ * to 1. Once an option is explored its siblings cap that vertex below the label tried, so no
+ * labeling is visited twice. A node is pruned when its weight plus the fractional bound of the
+ * coverage still missing (see residualBound) cannot beat the best solution, which starts as the
+ * greedy one or the one given to setUpperBound().
+ *
+ * @return ExactResult The best solution, its weight, a lower bound (the weight itself when the
+ *         search completed), whether it is proven optimal and the number of nodes explored.
+ */
+
+ExactResult ExactSolver::solve() {
+    this->nodes = 0;
+    this->aborted = false;
+    this->greedy();
+
+    if (this->bestWeight > this->rootBound)
+        this->branch(0);
+
+    bool optimal = !this->aborted;
+    return { this->bestSolution, this->bestWeight, optimal ? this->bestWeight : this->rootBound, optimal,
+             this->nodes };
+}
+
+bool ExactSolver::isDominated(size_t vertex) const {
+    uint64_t neighbors = this->neighborhoods[vertex];
+    int label = this->labels[vertex];
+
+    return (label >= 2) || (neighbors & this->labeled3) ||
+           ((label == 1) && (neighbors & this->labeled2)) || (popcount(neighbors & this->labeled2) >= 2);
+}
+
+void ExactSolver::setLabel(size_t vertex, int label) {
+    uint64_t bit = uint64_t(1) << vertex;
+
+    this->labels[vertex] = label;
+    this->labeled3 = label == 3 ? this->labeled3 | bit : this->labeled3 & ~bit;
+    this->labeled2 = label == 2 ? this->labeled2 | bit : this->labeled2 & ~bit;
+}
+
+/**
+ * @brief Lower bound on the weight still to be added to the current labeling.
+ *
+ * The coverage still missing at each vertex, its deficit, must be bought from raises within its
+ * closed neighborhood. A raise of u pays at least (new label - label) per unit of deficit it can
+ * remove, counting the gain at u and at its neighbors up to their deficits, times the cost of u, so
+ * each deficit costs at least the cheapest ratio around its vertex.
+ *
+ * @param deficits Filled with the deficit of every vertex, 0 for the dominated ones.
+ * @param infeasible Set when a deficit cannot be removed because every label around it is capped.
+ * @return double The bound.
+ */
+
+double ExactSolver::residualBound(std::vector<double>& deficits, bool& infeasible) const {
+    deficits.assign(this->order, 0.0);
+
+    for (size_t i = 0; i < this->order; ++i) {
+        uint64_t neighbors = this->neighborhoods[i];
+        double coverage = selfCoverage[this->labels[i]] + popcount(neighbors & this->labeled3) +
+                          0.5 * popcount(neighbors & this->labeled2);
+        deficits[i] = coverage < 1.0 ? 1.0 - coverage : 0.0;
+    }
+
+    std::vector<double> ratios(this->order, std::numeric_limits<double>::infinity());
+
+    for (size_t u = 0; u < this->order; ++u) {
+        int label = this->labels[u];
+
+        for (int raised = label + 1; raised <= this->caps[u]; ++raised) {
+            double selfGain = selfCoverage[raised] - selfCoverage[label];
+            double neighborGain = neighborCoverage[raised] - neighborCoverage[label];
+            double gain = std::min(selfGain, deficits[u]);
+
+            for (uint64_t m = this->neighborhoods[u]; m; m &= m - 1)
+                gain += std::min(neighborGain, deficits[__builtin_ctzll(m)]);
+
+            if (gain > 0.0)
+                ratios[u] = std::min(ratios[u], (raised - label) * this->costs[u] / gain);
+        }
+    }
+
+    double bound = 0.0;
+    infeasible = false;
+
+    for (size_t v = 0; v < this->order; ++v) {
+        if (deficits[v] == 0.0)
+            continue;
+
+        double ratio = ratios[v];
+        for (uint64_t m = this->neighborhoods[v]; m; m &= m - 1)
+            ratio = std::min(ratio, ratios[__builtin_ctzll(m)]);
+
+        if (std::isinf(ratio)) {
+            infeasible = true;
+            return bound;
+        }
+
+        bound += deficits[v] * ratio;
+    }
+
+    return bound;
+}
+
+void ExactSolver::branch(size_t weight) {
+    if (this->aborted)
+        return;
+
+    if ((this->maxNodes > 0) && (this->nodes >= this->maxNodes)) {
+        this->aborted = true;
+        return;
+    }
+
+    ++this->nodes;
+
+    std::vector<double> deficits;
+    bool infeasible = false;
+    double bound = this->residualBound(deficits, infeasible);
+
+    if (infeasible)
+        return;
+
+    size_t chosen = this->order;
+    size_t fewestOptions = std::numeric_limits<size_t>::max();
+
+    for (size_t v = 0; v < this->order; ++v) {
+        if (deficits[v] == 0.0)
+            continue;
+
+        size_t options = (this->labels[v] < 2 ? 1 : 0) + (this->labels[v] == 0 ? 1 : 0);
+        for (uint64_t m = this->neighborhoods[v]; m; m &= m - 1) {
+            size_t u = __builtin_ctzll(m);
+            options += (this->caps[u] > this->labels[u] ? 1 : 0) + (this->labels[u] < 2 && this->caps[u] >= 2 ? 1 : 0);
+        }
+
+        if ((options < fewestOptions) || ((options == fewestOptions) && (deficits[v] > deficits[chosen]))) {
+            chosen = v;
+            fewestOptions = options;
+        }
+    }
+
+    if (chosen == this->order) {
+        if (weight < this->bestWeight) {
+            this->bestWeight = weight;
+            this->bestSolution = this->labels;
+        }
+        return;
+    }
+
+    if (weight + static_cast<size_t>(std::ceil(bound - 1e-9)) >= this->bestWeight)
+        return;
+
+    std::vector<size_t> neighbors;
+    for (uint64_t m = this->neighborhoods[chosen]; m; m &= m - 1)
+        neighbors.push_back(__builtin_ctzll(m));
+
+    std::sort(neighbors.begin(), neighbors.end(), [this](size_t a, size_t b) {
+        return this->degrees[a] > this->degrees[b];
+    });
+
+    std::vector<std::pair<size_t, int>> options;
+    for (const auto& u: neighbors)
+        if ((this->labels[u] < 3) && (this->caps[u] >= 3))
+            options.push_back({ u, 3 });
+    if ((this->labels[chosen] < 2) && (this->caps[chosen] >= 2))
+        options.push_back({ chosen, 2 });
+    for (const auto& u: neighbors)
+        if ((this->labels[u] < 2) && (this->caps[u] >= 2))
+            options.push_back({ u, 2 });
+    if ((this->labels[chosen] == 0) && (this->caps[chosen] >= 1))
+        options.push_back({ chosen, 1 });
+
+    std::vector<std::pair<size_t, int>> savedCaps;
+
+    for (const auto& option: options) {
+        size_t vertex = option.first;
+        int label = this->labels[vertex];
+
+        this->setLabel(vertex, option.second);
+        this->branch(weight + (option.second - label) * this->costs[vertex]);
+        this->setLabel(vertex, label);
+
+        savedCaps.push_back({ vertex, this->caps[vertex] });
+        this->caps[vertex] = option.second - 1;
+    }
+
+    for (auto it = savedCaps.rbegin(); it != savedCaps.rend(); ++it)
+        this->caps[it->first] = it->second;
+}
+
+/**
+ * @brief First upper bound: labels 3 the vertex dominating the most undominated vertices per unit
+ * of cost until no vertex dominates two undominated ones, then labels 2 the vertices left.
+ */
+
+void ExactSolver::greedy() {
+    uint64_t undominated = this->order == maxOrder ? ~uint64_t(0) : (uint64_t(1) << this->order) - 1;
+    size_t weight = 0;
+
+    while (undominated) {
+        size_t best = 0, bestGain = 0, maxGain = 0;
+
+        for (size_t u = 0; u < this->order; ++u) {
+            size_t gain = popcount((this->neighborhoods[u] | (uint64_t(1) << u)) & undominated);
+            maxGain = std::max(maxGain, gain);
+            if (gain * this->costs[best] > bestGain * this->costs[u]) {
+                best = u;
+                bestGain = gain;
+            }
+        }
+
+        if (maxGain == 1) {
+            for (uint64_t m = undominated; m; m &= m - 1) {
+                size_t vertex = __builtin_ctzll(m);
+                this->setLabel(vertex, 2);
+                weight += 2 * this->costs[vertex];
+            }
+            break;
+        }
+
+        this->setLabel(best, 3);
+        weight += 3 * this->costs[best];
+        undominated &= ~(this->neighborhoods[best] | (uint64_t(1) << best));
+    }
+
+    if (weight < this->bestWeight) {
+        this->bestWeight = weight;
+        this->bestSolution = this->labels;
+    }
+
+    for (size_t i = 0; i < this->order; ++i)
+        this->setLabel(i, 0);
+}
@@ -1,4 +1,7 @@
 #include "GeneticAlgorithm.hpp"
+#include "Random.hpp"
+#include "Profiler.hpp"
+#include <chrono>
  
  /**
  * @brief Retrieves the current population of chromosomes.
@@ -43,291 +46,296 @@ Graph GeneticAlgorithm::getGraph() { return this->graph; }
 std::vector<int> GeneticAlgorithm::getBestSolution() { return this->bestSolution; } 
 
 /**
- * @brief Creates an initial population of chromosomes.
- * 
- * Initializes chromosomes using a heuristic function, if provided, or with random genes otherwise.
- * 
- * @param generateChromosomeHeuristic A pointer to a function generating chromosomes based on a graph.
- * @param graph The graph used to initialize the chromosomes.
+ * @brief Retrieves the number of candidate solutions evaluated (feasibility checks) so far.
+ * @return The number of evaluations as a size_t.
  */
+ 
+size_t GeneticAlgorithm::getNumberOfEvaluations() { return this->evaluations; }
 
-void GeneticAlgorithm::createPopulation(Chromosome(*generateChromosomeHeuristic)(Graph), Graph graph) {
-    if (generateChromosomeHeuristic) {  
-       Chromosome func = (*generateChromosomeHeuristic)(graph);  
-       for (size_t i = 0; i < populationSize; ++i) {
-            this->population[i] = Chromosome(func);
-            this->population[i].indexRemove = i;
-       }
-   } 
-        
-   else {
-       for (size_t i = 0; i < populationSize; ++i) {
-           this->population[i] = Chromosome(genesSize); 
-           this->population[i].indexRemove = i;
-       }
-   }
+/**
+ * @brief Sets a function called after every generation with its index and the best solution so far.
+ */
+
+void GeneticAlgorithm::setGenerationCallback(std::function<void(size_t, const std::vector<int>&)> generationCallback) {
+    this->generationCallback = generationCallback;
 }
 
 /**
- * @brief Calculates the fitness score for a chromosome.
- * 
- * Uses a fitness heuristic if provided; otherwise, computes fitness based on gene values.
- * 
- * @param chromosome Reference to the chromosome to evaluate.
- * @param fitnessHeuristic A pointer to a function that calculates fitness.
- * @return The evaluated chromosome with a fitness score.
+ * @brief Sets a flag, owned by the caller, that another thread raises to stop the run after the
+ * current generation; a null pointer disables cancellation.
  */
 
-Chromosome GeneticAlgorithm::fitness(Chromosome& chromosome, Chromosome(*fitnessHeuristic)(Chromosome&) = nullptr) { 
-    if (fitnessHeuristic)
-        return (*fitnessHeuristic)(chromosome);
-
-    for (size_t i = 0; i < chromosome.genesSize; ++i)
-        chromosome.fitnessValue += chromosome.genes[i];
-    return chromosome;
+void GeneticAlgorithm::setCancellationFlag(const std::atomic<bool>* cancellationFlag) {
+    this->cancellationFlag = cancellationFlag;
 }
 
 /**
- * @brief Selects the chromosome from the population using tournament selection.
- * 
- * This method randomly selects two chromosomes from the population, evaluates their fitness, 
- * and choses a random number r between 0 and 1. If r < k (where k is a parameters, for example 0.75),
- * fitter of the two parameters is selected to be a parent; otherwise, the one with the higher fitness value is selected.
- * 
- * @param population The vector of chromosomes in the current population.
- * @return Chromosome The chromosome with the highest or lowest fitness value.
+ * @brief Sets the wall-clock budget of each run(), in seconds, checked before every generation;
+ * 0 disables it.
  */
 
-Chromosome GeneticAlgorithm::tournamentSelection(std::vector<Chromosome> population) { 
-    constexpr float parameter = 0.75f; 
-    std::random_device randomNumber;
-    std::mt19937 seed(randomNumber());
-    std::uniform_int_distribution<int> gap(0, population.size() - 1);
-    std::uniform_real_distribution<float> probability(0, 1); 
-    
-    
-    Chromosome c1 = GeneticAlgorithm::fitness(population[gap(seed)], nullptr);
-    Chromosome c2 = GeneticAlgorithm::fitness(population[gap(seed)], nullptr);
-   
-    if (probability(seed) < parameter) 
-       return GeneticAlgorithm::chooseBestSolution(c1, c2);
-    else 
-       return GeneticAlgorithm::chooseWorstSolution(c1, c2); 
-}
+void GeneticAlgorithm::setTimeBudget(double seconds) { this->timeBudget = seconds; }
 
 /**
- * @brief Selects a chromosome using roulette wheel selection.
- * 
- * Returns a chromosome based on fitness-weighted random selection.
- * 
- * @param population The vector of chromosomes in the population.
- * @return A randomly selected chromosome.
+ * @brief Shares incumbents with an algorithm running concurrently (see exchangeIncumbent); a
+ * null pointer disables sharing.
  */
 
-Chromosome GeneticAlgorithm::rouletteWheelSelection(std::vector<Chromosome> population) {
-    size_t totalFitness = 0;
-
-    for (size_t i = 0; i < population.size(); ++i) {
-        fitness(population[i], nullptr);
-        totalFitness += population[i].fitnessValue;
-    }
-
-    std::random_device randomNumber;
-    std::mt19937 seed(randomNumber());
-    std::uniform_int_distribution<> distribution(0, totalFitness - 1);
-    size_t randomValue = distribution(seed);
-
-    size_t cumulativeFitness = 0;
-    for (auto& chromosome: population) {
-        cumulativeFitness += chromosome.fitnessValue;
-        if (cumulativeFitness >= randomValue) 
-            return chromosome;
-    }
-    
-    return population.back();
+void GeneticAlgorithm::setSharedIncumbent(SharedIncumbent* sharedIncumbent) {
+    this->sharedIncumbent = sharedIncumbent;
 }
 
 /**
- * @brief Selects and removes a chromosome based on a heuristic.
- * 
- * Uses the provided heuristic to select and remove a chromosome to prevent duplicates.
- * 
- * @param selectionHeuristic A pointer to a selection function.
- * @return The selected chromosome.
+ * @brief Sets a lower bound on γdR; the run stops after the generation whose best solution reaches
+ * it, which is then optimal. 0 disables the check.
  */
 
-Chromosome GeneticAlgorithm::selectionMethod(Chromosome(*selectionHeuristic)(std::vector<Chromosome>)) {
-    if (!selectionHeuristic) 
-        return Chromosome(); 
-  
-    Chromosome selected = (*selectionHeuristic)(this->population);
-    
-    if (selected.indexRemove >= 0 && selected.indexRemove < this->population.size()) 
-    	this->population.erase(this->population.begin() + selected.indexRemove);
+void GeneticAlgorithm::setLowerBound(size_t lowerBound) { this->lowerBound = lowerBound; }
 
-    return selected; 
-}
+/**
+ * @brief Snapshots the run to `path` every `interval` generations and when it ends, through a
+ * writer owned by the caller that saves them in the background; a null writer disables it.
+ */
 
+void GeneticAlgorithm::setCheckpoint(CheckpointWriter* checkpointWriter, const std::string& path, size_t interval) {
+    this->checkpointWriter = checkpointWriter;
+    this->checkpointPath = path;
+    this->checkpointInterval = interval;
+}
 
 /**
- * @brief Chooses the best Chromosome between two options based on their fitness values.
- * 
- * @param chromosome1 constant reference to the first Chromosome.
- * @param chromosome2 constant reference  to the second Chromosome.
- * @return Chromosome The Chromosome with the higher fitness value.
+ * @brief Loads a checkpoint written by a run with the same graph and parameters; the next run()
+ * continues it instead of creating a population. With the same random stream, it evolves exactly
+ * the population the interrupted run would have, and a checkpoint of a finished run only restores
+ * its best solution. Runs sharing an incumbent (hybrid mode) resume, but not bit-identically.
+ *
+ * @throws std::runtime_error if the file is not a GA checkpoint of this graph and population.
  */
 
-Chromosome GeneticAlgorithm::chooseBestSolution(const Chromosome& chromosome1, const Chromosome& chromosome2) {
-	    return (chromosome1.fitnessValue > chromosome2.fitnessValue ? chromosome1 : chromosome2);
+void GeneticAlgorithm::resume(const std::string& path) {
+    CheckpointReader reader(path, CheckpointKind::GeneticAlgorithm, this->graph);
+
+    if ((reader.read<uint64_t>() != this->populationSize) || (reader.read<uint64_t>() != this->genesSize))
+        throw std::runtime_error(path + " was written for another population");
+
+    auto readChromosome = [&reader](Chromosome& chromosome) {
+        chromosome.genesSize = reader.read<uint64_t>();
+        chromosome.indexRemove = reader.read<uint64_t>();
+        chromosome.fitnessValue = reader.read<uint64_t>();
+        reader.readVector(chromosome.genes);
+    };
+
+    this->resumePoint.step = reader.read<uint64_t>();
+    this->resumePoint.finished = reader.read<bool>();
+    this->evaluations = reader.read<uint64_t>();
+    this->injectedWeight = reader.read<uint64_t>();
+    reader.readEngine(this->resumePoint.engine);
+    readChromosome(this->resumedBestSolution);
+
+    this->population.resize(reader.read<uint64_t>());
+    for (auto& chromosome: this->population)
+        readChromosome(chromosome);
+
+    this->resumePoint.pending = true;
 }
 
 /**
- * @brief Chooses the worst Chromosome between two options based on their fitness values.
- * 
- * @param chromosome1 constant reference to the first Chromosome.
- * @param chromosome2 constant reference to the second Chromosome.
- * @return Chromosome The Chromosome with the lower fitness value.
+ * @brief Serializes the population, the best solution, the counters and the random engine of the
+ * calling thread, and hands the bytes to the checkpoint writer.
+ *
+ * @param generation The next generation to run.
+ * @param bestSolution The best solution so far.
+ * @param finished Whether the run has ended.
  */
 
-Chromosome GeneticAlgorithm::chooseWorstSolution(const Chromosome& chromosome1, const Chromosome& chromosome2) {
-	    return (chromosome1.fitnessValue < chromosome2.fitnessValue ? chromosome1 : chromosome2);
+void GeneticAlgorithm::saveCheckpoint(size_t generation, const Chromosome& bestSolution, bool finished) {
+    PROFILE_SCOPE("GA::saveCheckpoint");
+    CheckpointBuffer buffer(CheckpointKind::GeneticAlgorithm, this->graph);
+
+    auto writeChromosome = [&buffer](const Chromosome& chromosome) {
+        buffer.write<uint64_t>(chromosome.genesSize);
+        buffer.write<uint64_t>(chromosome.indexRemove);
+        buffer.write<uint64_t>(chromosome.fitnessValue);
+        buffer.writeVector(chromosome.genes);
+    };
+
+    buffer.write<uint64_t>(this->populationSize);
+    buffer.write<uint64_t>(this->genesSize);
+    buffer.write<uint64_t>(generation);
+    buffer.write(finished);
+    buffer.write<uint64_t>(this->evaluations);
+    buffer.write<uint64_t>(this->injectedWeight);
+    buffer.writeEngine(Random::engine());
+    writeChromosome(bestSolution);
+
+    buffer.write<uint64_t>(this->population.size());
+    for (const auto& chromosome: this->population)
+        writeChromosome(chromosome);
+
+    this->checkpointWriter->submit(this->checkpointPath, std::move(buffer.getBytes()));
 }
 
 /**
- * @brief Performs crossover between two chromosomes.
- * 
- * Combines genes from two parents to produce an offspring. Uses a heuristic if provided.
- * 
- * @param chromosome1 The first parent chromosome.
- * @param chromosome2 The second parent chromosome.
- * @param crossOverHeuristic Optional pointer to a crossover function.
- * @return A new chromosome offspring.
+ * @brief Selects the operators of the next run(); see GeneticKernelFactory::create for the
+ * combinations available.
  */
 
-Chromosome GeneticAlgorithm::crossOver(Chromosome& chromosome1, Chromosome& chromosome2,
- 	Chromosome(*crossOverHeuristic)(Chromosome&, Chromosome&)) {
- 	
-   if (crossOverHeuristic)
-        return (*crossOverHeuristic)(chromosome1, chromosome2);
-     
-   std::random_device randomNumber;
-   std::mt19937 seed(randomNumber()); 
-   std::uniform_int_distribution<> gap(0, genesSize - 1);
-   size_t range1 = gap(seed);
-   size_t range2 = gap(seed);
-   
-   std::vector<int> x, y;
-
-   if (range1 > range2) 
-        std::swap(range1, range2);
-    
-   for (size_t i = range1; i <= range2; ++i) { 
-        x.push_back(chromosome1.genes[i]);
-        y.push_back(chromosome2.genes[i]);
-   }
+void GeneticAlgorithm::setOperators(const GeneticOperators& operators) { this->operators = operators; }
 
-   for (size_t i = range1, j = 0; i <= range2; ++i, ++j) {  
-       chromosome1.genes[i] = y[j];
-       chromosome2.genes[i] = x[j]; 
-  }
- 
-   Chromosome solution1 = chromosome1;
-   Chromosome solution2 = chromosome2;
+GeneticOperators GeneticAlgorithm::getOperators() { return this->operators; }
 
-   feasibilityCheck(solution1);
-   feasibilityCheck(solution2);
-    
-   return chooseBestSolution(solution1, solution2);
-}
+/**
+ * @brief Finds the chromosome of lowest weight in the population, the first one on ties.
+ */
 
+const Chromosome& GeneticAlgorithm::lightestChromosome() const {
+    size_t lightest = 0;
+    for (size_t i = 1; i < this->population.size(); ++i)
+        if (this->population[i].fitnessValue < this->population[lightest].fitnessValue)
+            lightest = i;
+
+    return this->population[lightest];
+}
 
 /**
- * @brief Checks and adjusts chromosome feasibility.
- * 
- * Ensures that the chromosome meets Double Roman Domination constraints based on the graph.
- * 
- * @param chromosome The chromosome to check.
- * @return The adjusted chromosome.
+ * @brief Finds the chromosome of highest weight in the population, the last one on ties.
  */
- 
-Chromosome GeneticAlgorithm::feasibilityCheck(Chromosome& chromosome) {	
-    bool hasNeighborWith3 = false;                     
-                                                                                                                                                            
-    for (size_t i = 0; i < genesSize; ++i) {
-        if (chromosome.genes[i] == 0) {
-            hasNeighborWith3 = false;
-            for (auto& neighbor : this->graph.getAdjacencyList(i)) {
-                if (chromosome.genes[neighbor] == 3) {
-                    hasNeighborWith3 = true;
-                    break; 
-                }
-            }
-
-            if (!hasNeighborWith3) 
-                chromosome.genes[i] = 2;
-        }
-    }
 
-    return chromosome;	
+Chromosome& GeneticAlgorithm::heaviestChromosome() {
+    size_t heaviest = 0;
+    for (size_t i = 1; i < this->population.size(); ++i)
+        if (this->population[i].fitnessValue >= this->population[heaviest].fitnessValue)
+            heaviest = i;
+
+    return this->population[heaviest];
 }
 
 /**
- * @brief Creates a new generation of chromosomes by performing crossover operations.
- *
- * This function generates a new population by selecting chromosomes from the current population using 
- * different selection heuristics (tournament and roulette wheel selection), performing crossover 
- * on selected pairs to create offspring, and adding them to the new population. The new population 
- * is intended to be genetically improved over previous generations.
- * 
- * @details This method begins by clearing the existing population. It then repeatedly selects two parent 
- * chromosomes from the current population—one chosen through tournament selection and the other through 
- * roulette wheel selection. A crossover operation is applied to the selected pair to produce a single 
- * offspring, which is then added to the new population vector. The process continues until the new population 
- * reaches the specified population size.
+ * @brief Continues the algorithm on a changed version of its graph: the next run() keeps the
+ * population of the last one, repaired for `graph`, with `solution` in place of its heaviest
+ * chromosome, instead of creating a new population.
  *
- * @return std::vector<Chromosome>& A reference to the newly created population vector, which now contains 
- * genetically modified offspring chromosomes.
+ * @param graph The graph after the change, with the same vertices.
+ * @param solution A double Roman dominating function of `graph`, e.g. the last best solution repaired.
+ * @throws std::invalid_argument if the graph or the solution have another order.
  */
 
-std::vector<Chromosome>& GeneticAlgorithm::createNewPopulation() {
-	std::vector<Chromosome> temp;
+void GeneticAlgorithm::warmStart(const Graph& graph, const std::vector<int>& solution) {
+    if ((graph.getOrder() != this->graph.getOrder()) || (solution.size() != graph.getOrder()))
+        throw std::invalid_argument("A warm start needs a graph and a solution of the same order");
 
-    while (temp.size() < populationSize) {
-        Chromosome selected1 = this->selectionMethod(tournamentSelection);
-        Chromosome selected2 = this->selectionMethod(rouletteWheelSelection);
-        Chromosome offspring = this->crossOver(selected1, selected2, nullptr);
-
-        temp.push_back(offspring);
-    }
-    
-	this->population.swap(temp);
-	
-    return population;
+    this->graph = graph;
+    this->warmStartSolution = solution;
+    this->warmStarted = true;
 }
 
 /**
  * @brief Runs the genetic algorithm for a specified number of generations.
  * 
- * Evolves the population over multiple generations and stores the best solution found.
+ * Evolves the population over multiple generations, through the kernel that the factory builds for
+ * the selected operators, and stores the lightest solution found. The generation callback sees the
+ * best solution after each generation, and the run ends early when the cancellation flag is raised,
+ * when the time budget is spent or when the best solution reaches the lower bound. With a shared incumbent, solutions are
+ * exchanged with the concurrent algorithm after each generation. With a checkpoint writer, the run
+ * is saved every `checkpointInterval` generations and when it ends; after resume() it continues
+ * from the checkpoint, and after warmStart() from the previous population.
  * 
  * @param generations Number of generations to evolve.
- * @param heuristic Function pointer for initializing chromosomes from a graph.
+ * @throws std::invalid_argument if the operators do not name an available kernel.
  */
 
-void GeneticAlgorithm::run(size_t generations, Chromosome(*heuristic)(Graph)) { 
+void GeneticAlgorithm::run(size_t generations) { 
+   Chromosome bestSolution;
+   size_t firstGeneration = 0;
+   bool cancelled = false;
+   auto start = std::chrono::steady_clock::now();
+
+   this->kernel = GeneticKernelFactory::create(this->operators, this->graph);
+
+   if (this->resumePoint.pending) {
+       this->resumePoint.pending = false;
+       Random::engine() = this->resumePoint.engine;
+       bestSolution = this->resumedBestSolution;
+       firstGeneration = this->resumePoint.finished ? generations : this->resumePoint.step;
+   } else {
+       if (this->warmStarted && !this->population.empty() && (this->population.size() == this->populationSize) &&
+           (this->population.front().genes.size() == this->genesSize)) {
+           PROFILE_SCOPE("GA::warmStart");
+           for (auto& chromosome: this->population)
+               this->kernel->repair(chromosome);
+           this->evaluations += this->population.size();
+       } else {
+           PROFILE_SCOPE("GA::createPopulation");
+           this->kernel->createPopulation(this->population, this->populationSize);
+       }
+
+       if (this->warmStarted) {
+           Chromosome& heaviest = this->heaviestChromosome();
+           heaviest.genes = this->warmStartSolution;
+           heaviest.fitnessValue = this->graph.getWeight(heaviest.genes);
+       }
+
+       bestSolution = this->lightestChromosome();
+   }
 
-   this->createPopulation(heuristic, graph);
+   this->warmStarted = false;
 
-   Chromosome currentBestSolution = this->tournamentSelection(this->population);                                         
-   Chromosome bestSolution = currentBestSolution;
+   size_t i = firstGeneration;
+   for (; i < generations; ++i) {        
+        if (cancellationFlag && cancellationFlag->load(std::memory_order_relaxed)) {
+            cancelled = true;
+            break;
+        }
+        if ((timeBudget > 0.0) && (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= timeBudget))
+            break;
 
-   for (size_t i = 0; i < generations; ++i) {        
-       	this->population.swap(this->createNewPopulation());
-        currentBestSolution = this->tournamentSelection(this->population);                                       
+        this->evaluations += this->kernel->nextGeneration(this->population, this->populationSize);
 
+        const Chromosome& currentBestSolution = this->lightestChromosome();
         if (bestSolution.fitnessValue > currentBestSolution.fitnessValue)
             bestSolution = currentBestSolution; 
+
+        if (sharedIncumbent)
+            this->exchangeIncumbent(bestSolution);
+
+        if (generationCallback)
+            generationCallback(i, bestSolution.genes);
+
+        if (bestSolution.fitnessValue <= lowerBound)
+            break;
+
+        if (checkpointWriter && (checkpointInterval > 0) && ((i + 1) % checkpointInterval == 0) && (i + 1 < generations))
+            this->saveCheckpoint(i + 1, bestSolution, false);
    }
 
     this->bestSolution = bestSolution.genes;
+
+    if (checkpointWriter)
+        this->saveCheckpoint(i, bestSolution, !cancelled);
+}
+
+/**
+ * @brief Exchanges solutions with the algorithm running concurrently through the shared incumbent.
+ *
+ * The best solution of the generation is offered to the shared slot. A lighter solution published
+ * by the ACO, not injected before, replaces the heaviest chromosome of the population and becomes
+ * the best solution, so the next generations recombine it.
+ *
+ * @param bestSolution The best solution so far, replaced by the imported one when it is lighter.
+ */
+
+void GeneticAlgorithm::exchangeIncumbent(Chromosome& bestSolution) {
+    size_t bestWeight = bestSolution.fitnessValue;
+    this->sharedIncumbent->offer(bestSolution.genes, bestWeight, IncumbentSource::GeneticAlgorithm);
+
+    auto shared = this->sharedIncumbent->load();
+    if (!shared || (shared->source != IncumbentSource::ACO) || (shared->weight >= bestWeight) ||
+        (shared->weight == this->injectedWeight))
+        return;
+
+    Chromosome& worst = this->heaviestChromosome();
+    worst.genes = shared->solution;
+    worst.fitnessValue = shared->weight;
+    bestSolution = worst;
+    this->injectedWeight = shared->weight;
 }
@@ -0,0 +1,120 @@
+#include "GeneticKernel.hpp"
+#include "DoubleRomanDomination.hpp"
+#include <sstream>
+#include <stdexcept>
+
+Chromosome Heuristic1::create(const Graph& graph) { return DoubleRomanDomination::heuristic1(graph); }
+
+Chromosome Heuristic2::create(const Graph& graph) { return DoubleRomanDomination::heuristic2(graph); }
+
+Chromosome Heuristic3::create(const Graph& graph) { return DoubleRomanDomination::heuristic3(graph); }
+
+/**
+ * @brief Parses "selection,crossover,backend,improvement", e.g. "tournament,uniform,lists"; missing
+ * or empty fields keep their defaults ("mixed,two-point,compact,none"). The names are checked by
+ * check().
+ */
+
+GeneticOperators GeneticOperators::parse(const std::string& specification) {
+    GeneticOperators operators;
+    std::stringstream stream(specification);
+    std::string field;
+    std::string* fields[] = { &operators.selection, &operators.crossover, &operators.backend, &operators.improvement };
+
+    for (size_t i = 0; std::getline(stream, field, ','); ++i) {
+        if (i >= 4)
+            throw std::invalid_argument("Too many genetic operators in " + specification);
+        if (!field.empty())
+            *fields[i] = field;
+    }
+
+    return operators;
+}
+
+/**
+ * @brief Checks the operators before a kernel is built from them.
+ *
+ * @throws std::invalid_argument for an unknown name or heuristic, or a tournament probability
+ *         outside [0, 1].
+ */
+
+void GeneticOperators::check() const {
+    if ((this->selection != "mixed") && (this->selection != "tournament") && (this->selection != "roulette"))
+        throw std::invalid_argument("Unknown selection " + this->selection);
+    if ((this->crossover != "two-point") && (this->crossover != "uniform"))
+        throw std::invalid_argument("Unknown crossover " + this->crossover);
+    if ((this->backend != "compact") && (this->backend != "lists"))
+        throw std::invalid_argument("Unknown graph backend " + this->backend);
+    if ((this->improvement != "none") && (this->improvement != "local-search"))
+        throw std::invalid_argument("Unknown improvement " + this->improvement);
+    if ((this->heuristic < 1) || (this->heuristic > 3))
+        throw std::invalid_argument("Unknown heuristic " + std::to_string(this->heuristic));
+    if ((this->tournamentProbability < 0.0f) || (this->tournamentProbability > 1.0f))
+        throw std::invalid_argument("The tournament probability must lie in [0, 1]");
+}
+
+namespace {
+
+template <class Selection, class Crossover, class Construction>
+std::unique_ptr<GenerationKernel> withBackend(const GeneticOperators& operators, const Graph& graph) {
+    bool memetic = operators.improvement == "local-search";
+
+    if (operators.backend == "compact")
+        return std::unique_ptr<GenerationKernel>(
+            new SpecializedGenerationKernel<Selection, Crossover, DominationRepair, Construction, CompactGraph>(
+                graph, memetic, operators.tournamentProbability));
+    if (operators.backend == "lists")
+        return std::unique_ptr<GenerationKernel>(
+            new SpecializedGenerationKernel<Selection, Crossover, DominationRepair, Construction, Graph>(
+                graph, memetic, operators.tournamentProbability));
+
+    throw std::invalid_argument("Unknown graph backend " + operators.backend);
+}
+
+template <class Selection, class Crossover>
+std::unique_ptr<GenerationKernel> withConstruction(const GeneticOperators& operators, const Graph& graph) {
+    switch (operators.heuristic) {
+        case 1: return withBackend<Selection, Crossover, Heuristic1>(operators, graph);
+        case 2: return withBackend<Selection, Crossover, Heuristic2>(operators, graph);
+        case 3: return withBackend<Selection, Crossover, Heuristic3>(operators, graph);
+    }
+
+    throw std::invalid_argument("Unknown heuristic " + std::to_string(operators.heuristic));
+}
+
+template <class Selection>
+std::unique_ptr<GenerationKernel> withCrossover(const GeneticOperators& operators, const Graph& graph) {
+    if (operators.crossover == "two-point")
+        return withConstruction<Selection, TwoPointCrossover>(operators, graph);
+    if (operators.crossover == "uniform")
+        return withConstruction<Selection, UniformCrossover>(operators, graph);
+
+    throw std::invalid_argument("Unknown crossover " + operators.crossover);
+}
+
+}
+
+/**
+ * @brief Maps runtime operator names to one of the kernels instantiated here, one per combination
+ * of selection ("mixed", "tournament", "roulette"), crossover ("two-point", "uniform"),
+ * construction heuristic (1, 2, 3) and graph backend ("compact", "lists"). With the improvement
+ * "local-search" the kernel is memetic; "none" keeps the plain generations. The tournament
+ * probability is passed to the selection.
+ *
+ * @param operators The operator names.
+ * @param graph The graph of the run; it must outlive the kernel.
+ * @throws std::invalid_argument if the operators fail GeneticOperators::check.
+ */
+
+std::unique_ptr<GenerationKernel> GeneticKernelFactory::create(const GeneticOperators& operators, const Graph& graph) {
+    operators.check();
+
+    if (operators.selection == "mixed")
+        return withCrossover<MixedSelection>(operators, graph);
+    if (operators.selection == "tournament")
+        return withCrossover<TournamentSelection>(operators, graph);
+    if (operators.selection == "roulette")
+        return withCrossover<RouletteWheelSelection>(operators, graph);
+
+    throw std::invalid_argument("Unknown selection " + operators.selection);
+}
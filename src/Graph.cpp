@@ -1,21 +1,17 @@
 #include "Graph.hpp"
+#include "Random.hpp"
+#include "Profiler.hpp"
+#include <stdexcept>
+#include <string>
 
-Graph::Graph(size_t order, bool isDirected, float probabilityOfEdge) {
-    this->isDirected = isDirected;
-    this->order = order;
-    this->size = 0;
-
+Graph::Graph(size_t order, bool isDirected, float probabilityOfEdge) : Graph(order, isDirected) {
     size_t connectedVertex = 0;
     float probability = 0.0;
 
-    std::random_device randomNumber;
-    std::mt19937 seed(randomNumber());
+    std::mt19937& seed = Random::engine();
     std::uniform_int_distribution<int> gap(0, order - 1);
     std::uniform_real_distribution<float> probabilityGap(0.0, 1.0);
 
-    for (size_t i = 0; i < order; ++i)
-        adjList[i] = {};
-
     for (size_t i = 0; i < order; ++i) {
         connectedVertex = gap(seed);
 
@@ -35,8 +31,19 @@ Graph::Graph(size_t order, bool isDirected, float probabilityOfEdge) {
     }
 }
 
+/**
+ * @brief Reads a graph file: a header line "order size", then `size` edges "u v" with vertices
+ * 0 to order - 1, any number per line, then optionally the keyword "costs" followed by the cost
+ * of each vertex, from 0 to order - 1.
+ *
+ * Self-loops and repeated edges are skipped, so getSize() may end up below the header's size.
+ *
+ * @throws std::runtime_error if the file cannot be opened, its header is invalid or its costs
+ *         section does not hold `order` positive integers.
+ * @throws std::out_of_range if an edge names a vertex outside 0 to order - 1.
+ */
+
 Graph::Graph(const std::string& filename, bool isDirected) {
-	this->isDirected = isDirected;
    	std::ifstream file(filename, std::fstream::in);
     
     if (!file) {
@@ -45,71 +52,201 @@ Graph::Graph(const std::string& filename, bool isDirected) {
     }
 
     std::string line;
+    size_t order = 0, edges = 0, edgesRead = 0;
     size_t source = 0, destination = 0;
 
     // Lê a primeira linha para obter order e size
-    if (std::getline(file, line)) {
-        std::stringstream ss(line);
-        ss >> this->order >> this->size; // Captura o número de vértices e arestas
-    }
+    std::getline(file, line);
+    std::stringstream ss(line);
+    if (!(ss >> order >> edges)) // Captura o número de vértices e arestas
+        throw std::runtime_error("Invalid graph header in " + filename);
 
-    // Inicializa a lista de adjacência para cada vértice
-    for (size_t i = 0; i < order; ++i) {
-        adjList[i] = {};
-    }
+    *this = Graph(order, isDirected);
 
     // Lê as arestas restantes
-    while (std::getline(file, line) && (adjList.size() < size)) {
+    while ((edgesRead < edges) && std::getline(file, line)) {
         std::stringstream ssEdges(line);
         
-        while (ssEdges >> source >> destination) {
+        while ((edgesRead < edges) && (ssEdges >> source >> destination)) {
             addEdge(source, destination);
-            // Verifica se o número de arestas já atingiu o tamanho desejado
-            if (adjList.size() >= size) break;
+            ++edgesRead;
         }
     }
-    
-    // addEdge increments size a value a twice 
-    this->size = size / 2;
+
+    std::string keyword;
+    if (!(file >> keyword))
+        return;
+    if (keyword != "costs")
+        throw std::runtime_error("Unexpected \"" + keyword + "\" after the edges of " + filename);
+
+    for (size_t i = 0; i < order; ++i) {
+        long long cost = 0;
+        if (!(file >> cost) || (cost <= 0))
+            throw std::runtime_error("Expected " + std::to_string(order) + " positive vertex costs in " + filename);
+        this->costs[i] = static_cast<size_t>(cost);
+    }
+}
+
+Graph::Graph(const Graph& graph) 
+    : order(graph.order), size(graph.size), isDirected(graph.isDirected), alive(graph.alive),
+      outNeighbors(graph.outNeighbors), outPositions(graph.outPositions), inNeighbors(graph.inNeighbors),
+      inPositions(graph.inPositions), costs(graph.costs) {
+    PROFILE_COUNT("Graph::copy");
 }
 
-Graph::Graph(const Graph& graph) {
-    this->adjList = graph.adjList;
-    this->order = graph.order;
-    this->size = graph.size;
-    this->isDirected = graph.isDirected;
+/**
+ * @brief Creates a graph with vertices 0 to order - 1 and no edges; edges are added with addEdge.
+ */
+
+Graph::Graph(size_t order, bool isDirected) 
+    : order(order), size(0), isDirected(isDirected), alive(order, true), outNeighbors(order), outPositions(order),
+      inNeighbors(isDirected ? order : 0), inPositions(isDirected ? order : 0), costs(order, 1) {}
+
+Graph::Graph() : Graph(0, false) {}
+
+/**
+ * @brief Adds the edge {source, destination}, or the arc (source, destination) on a directed graph.
+ *
+ * @return false, adding nothing, for a self-loop or an edge that already exists.
+ * @throws std::out_of_range if either endpoint is not a vertex of the graph.
+ */
+
+bool Graph::addEdge(size_t source, size_t destination) {
+    if (!vertexExists(source) || !vertexExists(destination))
+        throw std::out_of_range("Edge (" + std::to_string(source) + ", " + std::to_string(destination) + 
+                                ") has an endpoint outside the graph");
+
+    if ((source == destination) || edgeExists(source, destination))
+        return false;
+
+    if (this->isDirected == false) {
+        this->outPositions[source].push_back(this->outNeighbors[destination].size());
+        this->outPositions[destination].push_back(this->outNeighbors[source].size());
+        this->outNeighbors[source].push_back(destination);
+        this->outNeighbors[destination].push_back(source);
+    } else {
+        this->outPositions[source].push_back(this->inNeighbors[destination].size());
+        this->inPositions[destination].push_back(this->outNeighbors[source].size());
+        this->outNeighbors[source].push_back(destination);
+        this->inNeighbors[destination].push_back(source);
+    }
+
+    ++this->size;
+    return true;
 }
 
-Graph::Graph() {}
+/**
+ * @brief Removes the edge {source, destination}, or the arc (source, destination) on a directed
+ * graph, in O(deg(source)): the mirror position locates the entry in the other list.
+ *
+ * @return false, removing nothing, when the edge does not exist.
+ */
+
+bool Graph::removeEdge(size_t source, size_t destination) {
+    if (!vertexExists(source) || !vertexExists(destination))
+        return false;
+
+    std::vector<size_t>& neighbors = this->outNeighbors[source];
+    auto entry = std::find(neighbors.begin(), neighbors.end(), destination);
+    if (entry == neighbors.end())
+        return false;
+
+    size_t position = entry - neighbors.begin();
+    size_t mirror = this->outPositions[source][position];
 
-void Graph::addEdge(size_t source, size_t destination) {
     if (this->isDirected == false) {
-        this->adjList[source].push_back(destination);
-        this->adjList[destination].push_back(source);
-        this->size += 2;
+        unlink(this->outNeighbors, this->outPositions, this->outPositions, destination, mirror);
+        unlink(this->outNeighbors, this->outPositions, this->outPositions, source, position);
     } else {
-        this->adjList[source].push_back(destination);
-        this->size += 1;
+        unlink(this->inNeighbors, this->inPositions, this->outPositions, destination, mirror);
+        unlink(this->outNeighbors, this->outPositions, this->inPositions, source, position);
     }
+
+    --this->size;
+    return true;
 }
 
 bool Graph::edgeExists(size_t u, size_t v) const {
-    return std::find(adjList.at(u).begin(), adjList.at(u).end(), v) != adjList.at(u).end();
-}
+    if (!vertexExists(u) || !vertexExists(v))
+        return false;
 
-size_t Graph::getVertexDegree(size_t vertex) const {
-    return const_cast<const std::unordered_map<size_t, std::list<size_t>>&>(adjList).at(vertex).size();
+    const std::vector<size_t>& fromU = this->outNeighbors[u];
+    const std::vector<size_t>& toV = getInNeighbors(v);
+
+    if (fromU.size() <= toV.size())
+        return std::find(fromU.begin(), fromU.end(), v) != fromU.end();
+    return std::find(toV.begin(), toV.end(), u) != toV.end();
 }
 
+size_t Graph::getVertexDegree(size_t vertex) const { return this->outNeighbors.at(vertex).size(); }
+
+size_t Graph::getInDegree(size_t vertex) const { return getInNeighbors(vertex).size(); }
+
 size_t Graph::getSize() const { return this->size; }
 
 size_t Graph::getOrder() const { return this->order; }
 
-std::unordered_map<size_t, std::list<size_t>> Graph::getAdjacencyList() const { return this->adjList; }
+bool Graph::isDirectedGraph() const { return this->isDirected; }
 
-const std::list<size_t>& Graph::getAdjacencyList(size_t vertex) const { return this->adjList.at(vertex); }
+/**
+ * @brief Sets the cost of a vertex, the factor of its label in the weight of a labeling.
+ *
+ * @throws std::out_of_range if the vertex id is outside the graph.
+ * @throws std::invalid_argument if the cost is 0.
+ */
 
-bool Graph::vertexExists(size_t vertex) const { return adjList.find(vertex) != adjList.end(); }
+void Graph::setCost(size_t vertex, size_t cost) {
+    if (cost == 0)
+        throw std::invalid_argument("Vertex costs must be positive");
+    this->costs.at(vertex) = cost;
+}
+
+/**
+ * @brief Whether some vertex costs more than 1, i.e. whether rules that assume unit costs, such
+ * as the twin reductions of GraphReduction, are off. Takes O(n).
+ */
+
+bool Graph::isWeightedGraph() const {
+    return std::any_of(this->costs.begin(), this->costs.end(), [](size_t cost) { return cost != 1; });
+}
+
+/**
+ * @brief Weight of a labeling: the sum of label * cost over its labeled vertices (unlabeled
+ * entries, -1, weigh nothing).
+ */
+
+size_t Graph::getWeight(const std::vector<int>& labels) const {
+    size_t weight = 0;
+    size_t count = std::min(labels.size(), this->costs.size());
+
+    for (size_t i = 0; i < count; ++i)
+        weight += labels[i] > 0 ? labels[i] * this->costs[i] : 0;
+
+    return weight;
+}
+
+/**
+ * @brief Lists the vertices that have not been deleted, in increasing order.
+ */
+
+std::vector<size_t> Graph::getVertices() const {
+    std::vector<size_t> vertices;
+    vertices.reserve(this->order);
+
+    for (size_t i = 0; i < this->alive.size(); ++i)
+        if (this->alive[i])
+            vertices.push_back(i);
+
+    return vertices;
+}
+
+const std::vector<size_t>& Graph::getAdjacencyList(size_t vertex) const { return this->outNeighbors.at(vertex); }
+
+const std::vector<size_t>& Graph::getInNeighbors(size_t vertex) const { 
+    return this->isDirected ? this->inNeighbors.at(vertex) : this->outNeighbors.at(vertex); 
+}
+
+bool Graph::vertexExists(size_t vertex) const { return (vertex < this->alive.size()) && this->alive[vertex]; }
 
 /*
 void Graph::breadthFirstSearch() {
@@ -155,39 +292,83 @@ void Graph::depthFirstSearch() {
 
 */
 
+/**
+ * @brief Deletes a vertex and its (out-)neighbors, in O(sum of their degrees).
+ */
+
 void Graph::deleteAdjacencyList(size_t vertex) {
-    if (adjList.find(vertex) == adjList.end())
+    if (!vertexExists(vertex))
     	return;
 
-    std::queue<size_t> toDelete;
-    toDelete.push(vertex);
-    int currentVertex = -1;
+    std::vector<size_t> toDelete = this->outNeighbors[vertex];
+
+    deleteVertex(vertex);
+    for (const auto& it: toDelete)
+       	deleteVertex(it);
+}
+
+/**
+ * @brief Deletes a vertex and the edges incident to it in O(deg), using the positions of the
+ * mirror entries to unlink each edge from the other endpoint's list. Its id is not reused.
+ */
 
-    for (const auto& it: this->adjList[vertex])
-    	toDelete.push(it);
+void Graph::deleteVertex(size_t vertex) {
+    if (!vertexExists(vertex))
+        return;
 
-    while (!toDelete.empty()) {
-        currentVertex = toDelete.front();
-        toDelete.pop();
+    std::vector<size_t>& neighbors = this->outNeighbors[vertex];
+    std::vector<size_t>& positions = this->outPositions[vertex];
 
-        for (const auto& it: this->adjList[currentVertex])
-        	this->adjList[it].remove(currentVertex);
-       	deleteVertex(currentVertex);
+    if (this->isDirected == false) {
+        for (size_t i = 0; i < neighbors.size(); ++i)
+            unlink(this->outNeighbors, this->outPositions, this->outPositions, neighbors[i], positions[i]);
+    } else {
+        for (size_t i = 0; i < neighbors.size(); ++i)
+            unlink(this->inNeighbors, this->inPositions, this->outPositions, neighbors[i], positions[i]);
+        for (size_t i = 0; i < this->inNeighbors[vertex].size(); ++i)
+            unlink(this->outNeighbors, this->outPositions, this->inPositions, this->inNeighbors[vertex][i],
+                   this->inPositions[vertex][i]);
+
+        this->size -= this->inNeighbors[vertex].size();
+        this->inNeighbors[vertex].clear();
+        this->inPositions[vertex].clear();
     }
-}
 
-void Graph::deleteVertex(size_t vertex) {
-    this->size -= this->adjList[vertex].size();
-    this->adjList.erase(vertex);
+    this->size -= neighbors.size();
+    neighbors.clear();
+    positions.clear();
+    this->alive[vertex] = false;
     --this->order;
 }
 
-std::ostream& operator<< (std::ostream& os, const Graph& graph) {
-    for (const auto& pair : graph.adjList) {
-        size_t vertex = pair.first;  
+/**
+ * @brief Removes entry `position` of the list of `vertex` by moving the list's last entry into its
+ * slot and pointing that entry's mirror at the new slot.
+ *
+ * @param neighbors The lists holding the entry (out-lists, or in-lists of a directed graph).
+ * @param positions The mirror positions of `neighbors`.
+ * @param mirrorPositions The mirror positions of the lists the mirrors live in.
+ */
+
+void Graph::unlink(std::vector<std::vector<size_t>>& neighbors, std::vector<std::vector<size_t>>& positions,
+                   std::vector<std::vector<size_t>>& mirrorPositions, size_t vertex, size_t position) {
+    std::vector<size_t>& list = neighbors[vertex];
+    std::vector<size_t>& listPositions = positions[vertex];
+
+    if (position + 1 != list.size()) {
+        list[position] = list.back();
+        listPositions[position] = listPositions.back();
+        mirrorPositions[list[position]][listPositions[position]] = position;
+    }
 
+    list.pop_back();
+    listPositions.pop_back();
+}
+
+std::ostream& operator<< (std::ostream& os, const Graph& graph) {
+    for (const auto& vertex : graph.getVertices()) {
         os << vertex << " ----> ";
-        for (const auto& neighbor : pair.second) 
+        for (const auto& neighbor : graph.outNeighbors[vertex]) 
             os << neighbor << " ";  
         os << std::endl;
     }
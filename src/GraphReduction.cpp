@@ -0,0 +1,304 @@
+#include "GraphReduction.hpp"
+#include "ThreadPool.hpp"
+#include "Random.hpp"
+#include <exception>
+#include <map>
+#include <stdexcept>
+
+/**
+ * @brief Reduces a graph for double Roman domination and splits what remains into connected components.
+ *
+ * The rules keep the minimum weight γdR unchanged:
+ *  - an isolated vertex has no neighbor to dominate it, so it is labeled 2 and removed;
+ *  - of the false twins (non-adjacent vertices with the same neighborhood N) of a class, only
+ *    `maxTwinsPerClass` are kept: there is always a minimum solution where N alone dominates the
+ *    twins, which are then labeled 0, and at most two of them (one 3 or two 2s) help to dominate N.
+ *    Leaves are the twins of a support vertex, for which keeping `maxLeavesPerSupport` is enough,
+ *    since two leaves force a minimum solution to label their support 3.
+ * A class is only reduced when no neighbor of its twins has been removed, so the removed vertices
+ * never neighbor each other's classes and lift() can label them in any order.
+ *
+ * A component with a vertex adjacent to all the others is solved exactly, by labeling that
+ * vertex 3, the least weight of a connected graph with two or more vertices. Every other
+ * component becomes a graph of its own, with vertices renumbered from 0 and their costs.
+ *
+ * The twin and star rules assume unit costs, so on a weighted graph only isolated vertices are
+ * removed and every other component is left to the solver.
+ *
+ * @param graph The graph, with vertices 0 to order - 1.
+ * @throws std::invalid_argument if the graph is directed, where these rules do not hold.
+ */
+
+GraphReduction::GraphReduction(const Graph& graph)
+    : originalOrder(graph.getOrder()), fixedLabels(graph.getOrder(), -1), statistics() {
+    if (graph.isDirectedGraph())
+        throw std::invalid_argument("Graph reduction needs an undirected graph");
+
+    size_t order = this->originalOrder;
+    std::vector<std::vector<size_t>> adjacency(order);
+
+    for (size_t i = 0; i < order; ++i) {
+        if (!graph.vertexExists(i))
+            continue;
+
+        for (const auto& j: graph.getAdjacencyList(i)) {
+            if ((j == i) || (j >= order))
+                continue;
+            adjacency[i].push_back(j);
+            adjacency[j].push_back(i);
+        }
+    }
+
+    for (auto& neighbors: adjacency) {
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    }
+
+    bool weighted = graph.isWeightedGraph();
+    std::vector<bool> removed(order, false);
+    std::vector<bool> locked(order, false);
+    std::map<std::vector<size_t>, std::vector<size_t>> classes;
+
+    for (size_t i = 0; i < order; ++i) {
+        if (adjacency[i].empty()) {
+            this->fixedLabels[i] = 2;
+            removed[i] = true;
+            ++this->statistics.isolatedVertices;
+        }
+
+        else if (!weighted)
+            classes[adjacency[i]].push_back(i);
+    }
+
+    for (auto& twins: classes) {
+        const std::vector<size_t>& neighbors = twins.first;
+        std::vector<size_t>& members = twins.second;
+        bool leaves = neighbors.size() == 1;
+        size_t limit = leaves ? maxLeavesPerSupport : maxTwinsPerClass;
+
+        if (members.size() <= limit) {
+            // Two leaves are kept as they are, but lift() still relabels their support if that pays off.
+            if (leaves && (members.size() == limit))
+                this->twinClasses.push_back({ neighbors, members, {} });
+            continue;
+        }
+
+        bool safe = true;
+        for (const auto& neighbor: neighbors)
+            safe = safe && !removed[neighbor];
+        for (const auto& member: members)
+            safe = safe && !locked[member];
+
+        if (!safe)
+            continue;
+
+        for (const auto& neighbor: neighbors)
+            locked[neighbor] = true;
+        for (size_t i = limit; i < members.size(); ++i)
+            removed[members[i]] = true;
+
+        this->twinClasses.push_back({ neighbors, std::vector<size_t>(members.begin(), members.begin() + limit),
+                                      std::vector<size_t>(members.begin() + limit, members.end()) });
+        (leaves ? this->statistics.removedLeaves : this->statistics.removedTwins) += members.size() - limit;
+    }
+
+    std::vector<size_t> local(order, 0);
+    std::vector<bool> visited(removed);
+
+    for (size_t i = 0; i < order; ++i) {
+        if (visited[i])
+            continue;
+
+        std::vector<size_t> component = { i };
+        visited[i] = true;
+
+        for (size_t head = 0; head < component.size(); ++head)
+            for (const auto& j: adjacency[component[head]])
+                if (!visited[j]) {
+                    visited[j] = true;
+                    component.push_back(j);
+                }
+
+        for (size_t k = 0; k < component.size(); ++k)
+            local[component[k]] = k;
+
+        std::vector<size_t> degrees(component.size(), 0);
+        size_t center = component.size();
+
+        for (size_t k = 0; k < component.size(); ++k) {
+            for (const auto& j: adjacency[component[k]])
+                degrees[k] += removed[j] ? 0 : 1;
+            if (degrees[k] + 1 == component.size())
+                center = k;
+        }
+
+        ++this->statistics.components;
+
+        if ((center < component.size()) && !weighted) {
+            for (const auto& vertex: component)
+                this->fixedLabels[vertex] = 0;
+            this->fixedLabels[component[center]] = 3;
+            ++this->statistics.componentsSolvedExactly;
+            continue;
+        }
+
+        Graph reduced(component.size(), false);
+        for (size_t k = 0; k < component.size(); ++k)
+            reduced.setCost(k, graph.getCost(component[k]));
+        for (size_t k = 0; k < component.size(); ++k)
+            for (const auto& j: adjacency[component[k]])
+                if (!removed[j] && (local[j] > k))
+                    reduced.addEdge(k, local[j]);
+
+        this->statistics.reducedOrder += component.size();
+        this->componentVertices.push_back(std::move(component));
+        this->componentGraphs.push_back(std::move(reduced));
+    }
+}
+
+/**
+ * @brief Number of components left to a solver; the ones solved exactly are not counted.
+ */
+
+size_t GraphReduction::getNumberOfComponents() const { return this->componentGraphs.size(); }
+
+/**
+ * @brief The graph of a component, whose vertex k is getComponentVertices(component)[k].
+ */
+
+Graph& GraphReduction::getComponent(size_t component) { return this->componentGraphs.at(component); }
+
+const std::vector<size_t>& GraphReduction::getComponentVertices(size_t component) const {
+    return this->componentVertices.at(component);
+}
+
+const ReductionStatistics& GraphReduction::getStatistics() const { return this->statistics; }
+
+/**
+ * @brief Builds a solution of the original graph from one double Roman dominating function per component.
+ *
+ * The removed twins of a class get the least label that the final labels of their neighborhood
+ * allow: 0 next to a 3 or two 2s, 1 next to a 2, and 2 otherwise. Whenever a support vertex and
+ * its leaves weigh more than 3, the support is relabeled 3 and the leaves 0, so a component
+ * solution that misses the forced support is improved rather than inflated by the removed leaves.
+ *
+ * @param componentSolutions The labeling of each component, in component vertex order.
+ * @return std::vector<int> A double Roman dominating function of the original graph when every
+ *         component solution is one of its component.
+ * @throws std::invalid_argument if the number or the sizes of the component solutions do not match.
+ */
+
+std::vector<int> GraphReduction::lift(const std::vector<std::vector<int>>& componentSolutions) const {
+    if (componentSolutions.size() != this->componentVertices.size())
+        throw std::invalid_argument("Expected one solution per component");
+
+    std::vector<int> solution(this->fixedLabels);
+
+    for (size_t i = 0; i < componentSolutions.size(); ++i) {
+        const std::vector<size_t>& vertices = this->componentVertices[i];
+
+        if (componentSolutions[i].size() != vertices.size())
+            throw std::invalid_argument("Component solution of the wrong size");
+
+        for (size_t k = 0; k < vertices.size(); ++k)
+            solution[vertices[k]] = componentSolutions[i][k];
+    }
+
+    for (const auto& twins: this->twinClasses) {
+        size_t threes = 0, twos = 0;
+        for (const auto& neighbor: twins.neighbors) {
+            threes += solution[neighbor] == 3 ? 1 : 0;
+            twos += solution[neighbor] == 2 ? 1 : 0;
+        }
+
+        int label = (threes > 0) || (twos > 1) ? 0 : twos == 1 ? 1 : 2;
+        for (const auto& vertex: twins.removed)
+            solution[vertex] = label;
+    }
+
+    for (const auto& twins: this->twinClasses) {
+        if (twins.neighbors.size() != 1)
+            continue;
+
+        size_t support = twins.neighbors.front();
+        int weight = std::max(solution[support], 0);
+
+        for (const auto& vertex: twins.kept)
+            weight += std::max(solution[vertex], 0);
+        for (const auto& vertex: twins.removed)
+            weight += std::max(solution[vertex], 0);
+
+        if (weight <= 3)
+            continue;
+
+        solution[support] = 3;
+        for (const auto& vertex: twins.kept)
+            solution[vertex] = 0;
+        for (const auto& vertex: twins.removed)
+            solution[vertex] = 0;
+    }
+
+    return solution;
+}
+
+/**
+ * @brief Solves every component with `solver` and lifts the solutions to the original graph.
+ *
+ * Components are independent, so with more than one thread they run concurrently on a
+ * ThreadPool, largest first. Each solve reseeds its thread's random engine with a seed drawn
+ * from the caller's engine beforehand, so the result does not depend on the number of threads.
+ * Must not be called with more than one thread from a task of another ThreadPool, whose wait()
+ * would then wait for its caller.
+ *
+ * @param solver Returns a double Roman dominating function of the graph it is given.
+ * @param numberOfThreads Workers of the pool; 0 means one per hardware thread.
+ * @return std::vector<int> The solution of the original graph.
+ */
+
+std::vector<int> GraphReduction::solve(const std::function<std::vector<int>(Graph&)>& solver,
+                                       size_t numberOfThreads) {
+    size_t count = this->componentGraphs.size();
+    std::vector<std::vector<int>> solutions(count);
+    std::vector<unsigned int> seeds(count);
+    std::vector<size_t> schedule(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        seeds[i] = Random::engine()();
+        schedule[i] = i;
+    }
+
+    std::sort(schedule.begin(), schedule.end(), [this](size_t a, size_t b) {
+        return this->componentVertices[a].size() > this->componentVertices[b].size();
+    });
+
+    if ((numberOfThreads == 1) || (count < 2)) {
+        for (const auto& i: schedule) {
+            Random::seed(seeds[i]);
+            solutions[i] = solver(this->componentGraphs[i]);
+        }
+
+        return this->lift(solutions);
+    }
+
+    std::vector<std::exception_ptr> errors(count);
+    ThreadPool pool(numberOfThreads);
+
+    for (const auto& i: schedule) {
+        pool.submit([this, i, &solver, &solutions, &seeds, &errors]() {
+            try {
+                Random::seed(seeds[i]);
+                solutions[i] = solver(this->componentGraphs[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+
+    pool.wait();
+
+    for (const auto& error: errors)
+        if (error)
+            std::rethrow_exception(error);
+
+    return this->lift(solutions);
+}
@@ -0,0 +1,237 @@
+#include "LocalSearch.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+
+/**
+ * @brief Prepares a local search on a graph; its buffers are reused by every improve() call.
+ *
+ * @param graph The graph of the solutions to improve. It must outlive the local search.
+ */
+
+LocalSearch::LocalSearch(const Graph& graph) : graph(graph) {}
+
+/**
+ * @brief Improves a double Roman dominating function by best-improvement descent over the
+ * Lower, Swap and Merge moves (see LocalSearchMove) until none saves weight.
+ *
+ * The gain table holds the best move anchored at every vertex, in a max-heap keyed by gain. A
+ * move only changes the counters of the neighbors of the vertices it relabels, so afterwards only
+ * the entries of their closed neighborhoods are recomputed, O(deg) entries per move. Entries
+ * further away may have gone stale: a popped entry is evaluated again and re-queued when its gain
+ * dropped, and when the heap runs dry one sweep over all vertices collects moves that became
+ * improving out of reach of the updates. Every move saves weight, so the descent ends.
+ *
+ * @param solution A double Roman dominating function, replaced by the improved one.
+ * @param maxMoves Moves after which the search stops; 0 runs to a local optimum.
+ * @return size_t The weight of the improved solution.
+ */
+
+size_t LocalSearch::improve(std::vector<int>& solution, size_t maxMoves) {
+    PROFILE_SCOPE("LocalSearch::improve");
+    DominationState state(this->graph, solution);
+    size_t order = solution.size();
+    size_t moves = 0;
+
+    this->gains.assign(order, LocalSearchMove());
+    this->versions.assign(order, 0);
+    this->queue = std::priority_queue<std::tuple<long long, size_t, size_t>>();
+    ++this->statistics.calls;
+
+    for (size_t v = 0; v < order; ++v)
+        this->refresh(state, v);
+
+    while (true) {
+        while (!this->queue.empty() && ((maxMoves == 0) || (moves < maxMoves))) {
+            long long gain = std::get<0>(this->queue.top());
+            size_t vertex = std::get<1>(this->queue.top());
+            size_t version = std::get<2>(this->queue.top());
+            this->queue.pop();
+
+            if (version != this->versions[vertex])
+                continue;
+
+            LocalSearchMove move = this->evaluate(state, vertex);
+            if (move.gain < gain) {
+                this->record(vertex, move);
+                continue;
+            }
+
+            this->apply(state, move);
+            ++moves;
+
+            this->refreshAround(state, move.vertex);
+            if (move.type != MoveType::Lower)
+                this->refreshAround(state, move.partner);
+            if (move.second != none)
+                this->refreshAround(state, move.second);
+        }
+
+        if ((maxMoves > 0) && (moves >= maxMoves))
+            break;
+
+        bool improving = false;
+        ++this->statistics.sweeps;
+
+        for (size_t v = 0; v < order; ++v) {
+            this->refresh(state, v);
+            improving = improving || (this->gains[v].gain > 0);
+        }
+
+        if (!improving)
+            break;
+    }
+
+    solution = state.getLabels();
+    return state.getWeight();
+}
+
+const LocalSearchStatistics& LocalSearch::getStatistics() const { return this->statistics; }
+
+/**
+ * @brief Least label the vertex can take while its closed neighborhood stays dominated; its own
+ * label when it cannot be lowered.
+ */
+
+int LocalSearch::lowestLabel(const DominationState& state, size_t vertex) const {
+    int label = state.getLabel(vertex);
+
+    for (int lower = 0; lower < label; ++lower)
+        if (state.canRelabel(vertex, lower))
+            return lower;
+
+    return label;
+}
+
+/**
+ * @brief Finds the move anchored at a vertex that saves the most weight, Lower first on ties.
+ *
+ * Swap and Merge are tried by relabeling the state and undoing it, which costs O(deg) per
+ * neighbor tried; neighbors that cannot beat the best gain so far are skipped.
+ *
+ * @return LocalSearchMove The best move, with a gain of 0 when none saves weight.
+ */
+
+LocalSearchMove LocalSearch::evaluate(DominationState& state, size_t vertex) {
+    int label = state.getLabel(vertex);
+    long long cost = this->graph.getCost(vertex);
+    LocalSearchMove best = { MoveType::Lower, vertex, none, none, label, 0 };
+
+    if (label < 0)
+        return best;
+
+    int lowest = this->lowestLabel(state, vertex);
+    if (lowest < label)
+        best = { MoveType::Lower, vertex, none, none, lowest, (label - lowest) * cost };
+
+    if (label == 3) {
+        for (const auto& neighbor: this->graph.getAdjacencyList(vertex)) {
+            int neighborLabel = state.getLabel(neighbor);
+            if ((neighborLabel < 0) || (neighborLabel == 3))
+                continue;
+
+            long long raise = (3 - neighborLabel) * static_cast<long long>(this->graph.getCost(neighbor));
+            if (3 * cost - raise <= best.gain)
+                continue;
+
+            state.setLabel(neighbor, 3);
+            int remaining = this->lowestLabel(state, vertex);
+            state.setLabel(neighbor, neighborLabel);
+
+            long long gain = (3 - remaining) * cost - raise;
+            if (gain > best.gain)
+                best = { MoveType::Swap, vertex, neighbor, none, remaining, gain };
+        }
+    }
+
+    if (label < 3) {
+        this->candidates.clear();
+        for (const auto& neighbor: this->graph.getAdjacencyList(vertex))
+            if (state.getLabel(neighbor) == 2)
+                this->candidates.push_back(neighbor);
+
+        std::sort(this->candidates.begin(), this->candidates.end(), [this](size_t a, size_t b) {
+            return this->graph.getCost(a) > this->graph.getCost(b);
+        });
+
+        long long raise = (3 - label) * cost;
+        long long bound = 0;
+        for (size_t i = 0; (i < 2) && (i < this->candidates.size()); ++i)
+            bound += 2 * static_cast<long long>(this->graph.getCost(this->candidates[i]));
+
+        if (bound - raise > best.gain) {
+            size_t dropped[2] = { none, none };
+            size_t numberDropped = 0;
+            long long saved = 0;
+
+            state.setLabel(vertex, 3);
+            for (size_t i = 0; (i < this->candidates.size()) && (numberDropped < 2); ++i)
+                if (state.canRelabel(this->candidates[i], 0)) {
+                    state.setLabel(this->candidates[i], 0);
+                    dropped[numberDropped++] = this->candidates[i];
+                    saved += 2 * static_cast<long long>(this->graph.getCost(this->candidates[i]));
+                }
+
+            for (size_t i = 0; i < numberDropped; ++i)
+                state.setLabel(dropped[i], 2);
+            state.setLabel(vertex, label);
+
+            if ((numberDropped > 0) && (saved - raise > best.gain))
+                best = { MoveType::Merge, vertex, dropped[0], dropped[1], 3, saved - raise };
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief Recomputes the gain table entry of a vertex and queues it when it saves weight; the
+ * entry queued before, if any, is invalidated.
+ */
+
+void LocalSearch::refresh(DominationState& state, size_t vertex) { this->record(vertex, this->evaluate(state, vertex)); }
+
+void LocalSearch::record(size_t vertex, const LocalSearchMove& move) {
+    this->gains[vertex] = move;
+    ++this->versions[vertex];
+
+    if (move.gain > 0)
+        this->queue.push(std::make_tuple(move.gain, vertex, this->versions[vertex]));
+}
+
+/**
+ * @brief Refreshes a relabeled vertex and the vertices whose counters its label feeds or reads.
+ */
+
+void LocalSearch::refreshAround(DominationState& state, size_t vertex) {
+    this->refresh(state, vertex);
+
+    for (const auto& neighbor: this->graph.getAdjacencyList(vertex))
+        this->refresh(state, neighbor);
+
+    if (this->graph.isDirectedGraph())
+        for (const auto& neighbor: this->graph.getInNeighbors(vertex))
+            this->refresh(state, neighbor);
+}
+
+void LocalSearch::apply(DominationState& state, const LocalSearchMove& move) {
+    switch (move.type) {
+        case MoveType::Lower:
+            state.setLabel(move.vertex, move.label);
+            ++this->statistics.lowered;
+            break;
+
+        case MoveType::Swap:
+            state.setLabel(move.partner, 3);
+            state.setLabel(move.vertex, move.label);
+            ++this->statistics.swapped;
+            break;
+
+        case MoveType::Merge:
+            state.setLabel(move.vertex, 3);
+            state.setLabel(move.partner, 0);
+            if (move.second != none)
+                state.setLabel(move.second, 0);
+            ++this->statistics.merged;
+            break;
+    }
+}
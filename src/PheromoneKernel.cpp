@@ -0,0 +1,204 @@
+#include "PheromoneKernel.hpp"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PHEROMONE_KERNEL_X86 1
+#endif
+
+/**
+ * @brief Checks, at runtime, whether the processor supports AVX2.
+ */
+
+bool PheromoneKernel::hasAVX2() {
+#ifdef PHEROMONE_KERNEL_X86
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Chooses the update implementation once, based on the processor features.
+ */
+
+PheromoneKernel::UpdateFunction PheromoneKernel::select() {
+    return hasAVX2() ? updateAVX2 : updateScalar;
+}
+
+const char* PheromoneKernel::getImplementationName() { return hasAVX2() ? "avx2" : "scalar"; }
+
+/**
+ * @brief Fused Hyper-Cube Framework pheromone update.
+ *
+ * In a single pass over the pheromone array, each value moves towards its target,
+ * tau += evaporationRate * (target - tau), where the target is `currentBestShare` if the vertex is
+ * labeled 3 in the iteration-best solution plus `bestShare` if it is labeled 3 in the best-so-far
+ * solution. The value is then clamped to the MAX-MIN bounds, and the observed minimum, maximum and
+ * convergence factor are accumulated:
+ *
+ * cf = 2 * (sum(max(maxBound - tau, tau - minBound)) / (size * (maxBound - minBound)) - 0.5)
+ *
+ * which is 0 when every value is halfway between the bounds and 1 when all of them sit on a bound.
+ *
+ * @param pheromone The pheromone array, updated in place. Best performance if 32-byte aligned.
+ * @param currentBestSolution The iteration-best labeling.
+ * @param bestSolution The best-so-far labeling.
+ * @param size Number of vertices.
+ * @return The minimum, maximum and convergence factor after the update.
+ */
+
+PheromoneSummary PheromoneKernel::update(float* pheromone, const int* currentBestSolution,
+                                         const int* bestSolution, size_t size, float currentBestShare,
+                                         float bestShare, float evaporationRate, float minBound, float maxBound) {
+    static const UpdateFunction implementation = select();
+
+    if (size == 0)
+        return { minBound, maxBound, 0.0f };
+
+    return implementation(pheromone, currentBestSolution, bestSolution, size, currentBestShare,
+                          bestShare, evaporationRate, minBound, maxBound);
+}
+
+/**
+ * @brief The non-fused update: one pass per quantity, as the update used to be computed.
+ * Kept as the baseline of the pheromone microbenchmark.
+ */
+
+PheromoneSummary PheromoneKernel::updateReference(float* pheromone, const int* currentBestSolution,
+                                                  const int* bestSolution, size_t size, float currentBestShare,
+                                                  float bestShare, float evaporationRate, float minBound, float maxBound) {
+    for (size_t i = 0; i < size; ++i) {
+        float target = currentBestShare * (currentBestSolution[i] == 3) + bestShare * (bestSolution[i] == 3);
+        pheromone[i] += evaporationRate * (target - pheromone[i]);
+    }
+
+    for (size_t i = 0; i < size; ++i)
+        pheromone[i] = std::min(maxBound, std::max(minBound, pheromone[i]));
+
+    std::vector<float> values(pheromone, pheromone + size);
+    PheromoneSummary summary = { *std::min_element(values.begin(), values.end()),
+                                 *std::max_element(values.begin(), values.end()), 0.0f };
+    double sum = 0.0;
+
+    for (const auto& it: values)
+        sum += std::max(maxBound - it, it - minBound);
+
+    summary.convergenceFactor = 2.0f * static_cast<float>(sum / (size * (maxBound - minBound)) - 0.5);
+
+    return summary;
+}
+
+PheromoneSummary PheromoneKernel::updateScalar(float* pheromone, const int* currentBestSolution,
+                                               const int* bestSolution, size_t size, float currentBestShare,
+                                               float bestShare, float evaporationRate, float minBound, float maxBound) {
+    PheromoneSummary summary = { maxBound, minBound, 0.0f };
+    double sum = 0.0;
+
+    for (size_t i = 0; i < size; ++i) {
+        float target = currentBestShare * (currentBestSolution[i] == 3) + bestShare * (bestSolution[i] == 3);
+        float value = pheromone[i] + evaporationRate * (target - pheromone[i]);
+
+        value = std::min(maxBound, std::max(minBound, value));
+        pheromone[i] = value;
+
+        summary.minPheromone = std::min(summary.minPheromone, value);
+        summary.maxPheromone = std::max(summary.maxPheromone, value);
+        sum += std::max(maxBound - value, value - minBound);
+    }
+
+    summary.convergenceFactor = 2.0f * static_cast<float>(sum / (size * (maxBound - minBound)) - 0.5);
+
+    return summary;
+}
+
+#ifdef PHEROMONE_KERNEL_X86
+
+__attribute__((target("avx2")))
+PheromoneSummary PheromoneKernel::updateAVX2(float* pheromone, const int* currentBestSolution,
+                                             const int* bestSolution, size_t size, float currentBestShare,
+                                             float bestShare, float evaporationRate, float minBound, float maxBound) {
+    const __m256i three = _mm256_set1_epi32(3);
+    const __m256 currentShare = _mm256_set1_ps(currentBestShare);
+    const __m256 share = _mm256_set1_ps(bestShare);
+    const __m256 rate = _mm256_set1_ps(evaporationRate);
+    const __m256 lower = _mm256_set1_ps(minBound);
+    const __m256 upper = _mm256_set1_ps(maxBound);
+
+    __m256 minimum = upper;
+    __m256 maximum = lower;
+    __m256 sum = _mm256_setzero_ps();
+    double total = 0.0;
+
+    size_t i = 0;
+    size_t block = 0;
+
+    for (; i + 8 <= size; i += 8) {
+        __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(currentBestSolution + i));
+        __m256i best = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bestSolution + i));
+        __m256 target = _mm256_add_ps(
+                _mm256_and_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(current, three)), currentShare),
+                _mm256_and_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(best, three)), share));
+
+        __m256 value = _mm256_loadu_ps(pheromone + i);
+        value = _mm256_add_ps(value, _mm256_mul_ps(rate, _mm256_sub_ps(target, value)));
+        value = _mm256_min_ps(upper, _mm256_max_ps(lower, value));
+        _mm256_storeu_ps(pheromone + i, value);
+
+        minimum = _mm256_min_ps(minimum, value);
+        maximum = _mm256_max_ps(maximum, value);
+        sum = _mm256_add_ps(sum, _mm256_max_ps(_mm256_sub_ps(upper, value), _mm256_sub_ps(value, lower)));
+
+        // Flushes the float lanes every 4096 elements to keep the accumulation accurate.
+        if (++block == 512) {
+            float lanes[8];
+            _mm256_storeu_ps(lanes, sum);
+            for (const auto& lane: lanes)
+                total += lane;
+            sum = _mm256_setzero_ps();
+            block = 0;
+        }
+    }
+
+    float lanes[8];
+    PheromoneSummary summary = { maxBound, minBound, 0.0f };
+
+    _mm256_storeu_ps(lanes, sum);
+    for (const auto& lane: lanes)
+        total += lane;
+
+    _mm256_storeu_ps(lanes, minimum);
+    for (const auto& lane: lanes)
+        summary.minPheromone = std::min(summary.minPheromone, lane);
+
+    _mm256_storeu_ps(lanes, maximum);
+    for (const auto& lane: lanes)
+        summary.maxPheromone = std::max(summary.maxPheromone, lane);
+
+    for (; i < size; ++i) {
+        float target = currentBestShare * (currentBestSolution[i] == 3) + bestShare * (bestSolution[i] == 3);
+        float value = pheromone[i] + evaporationRate * (target - pheromone[i]);
+
+        value = std::min(maxBound, std::max(minBound, value));
+        pheromone[i] = value;
+
+        summary.minPheromone = std::min(summary.minPheromone, value);
+        summary.maxPheromone = std::max(summary.maxPheromone, value);
+        total += std::max(maxBound - value, value - minBound);
+    }
+
+    summary.convergenceFactor = 2.0f * static_cast<float>(total / (size * (maxBound - minBound)) - 0.5);
+
+    return summary;
+}
+
+#else
+
+PheromoneSummary PheromoneKernel::updateAVX2(float* pheromone, const int* currentBestSolution,
+                                             const int* bestSolution, size_t size, float currentBestShare,
+                                             float bestShare, float evaporationRate, float minBound, float maxBound) {
+    return updateScalar(pheromone, currentBestSolution, bestSolution, size, currentBestShare,
+                        bestShare, evaporationRate, minBound, maxBound);
+}
+
+#endif
@@ -0,0 +1,189 @@
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+
+namespace {
+
+constexpr size_t maxTraceEventsPerThread = 1 << 20;
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::string> names;
+    std::vector<ProfileEntry> totals;
+    std::vector<size_t> threadsPerEvent;
+    std::vector<std::pair<size_t, std::vector<TraceEvent>>> traces;
+    size_t numberOfThreads;
+    std::string traceFile;
+    uint64_t origin;
+
+    Registry() : numberOfThreads(0), origin(Profiler::now()) {
+        const char* filename = std::getenv("DRD_TRACE_FILE");
+        if (filename)
+            traceFile = filename;
+    }
+
+    ~Registry() {
+        Profiler::writeSummary(std::cerr);
+        if (!traceFile.empty())
+            Profiler::writeChromeTrace(traceFile);
+    }
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+struct ThreadProfile {
+    size_t thread;
+    std::vector<ProfileEntry> entries;
+    std::vector<TraceEvent> trace;
+    bool tracing;
+
+    ThreadProfile() {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        thread = shared.numberOfThreads++;
+        tracing = !shared.traceFile.empty();
+    }
+
+    ProfileEntry& entry(size_t event) {
+        if (event >= entries.size())
+            entries.resize(event + 1, { 0, 0, UINT64_MAX, 0 });
+        return entries[event];
+    }
+
+    ~ThreadProfile() {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+
+        if (shared.totals.size() < entries.size()) {
+            shared.totals.resize(entries.size(), { 0, 0, UINT64_MAX, 0 });
+            shared.threadsPerEvent.resize(entries.size(), 0);
+        }
+
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (entries[i].calls == 0)
+                continue;
+
+            ProfileEntry& total = shared.totals[i];
+            total.calls += entries[i].calls;
+            total.totalNanoseconds += entries[i].totalNanoseconds;
+            total.minNanoseconds = std::min(total.minNanoseconds, entries[i].minNanoseconds);
+            total.maxNanoseconds = std::max(total.maxNanoseconds, entries[i].maxNanoseconds);
+            ++shared.threadsPerEvent[i];
+        }
+
+        if (!trace.empty())
+            shared.traces.push_back({ thread, std::move(trace) });
+    }
+};
+
+ThreadProfile& threadProfile() {
+    thread_local ThreadProfile profile;
+    return profile;
+}
+
+}
+
+/**
+ * @brief Registers a named event (a timed scope or a counter) and returns its identifier.
+ *
+ * Called once per call site, through the PROFILE_SCOPE and PROFILE_COUNT macros.
+ */
+
+size_t Profiler::registerEvent(const char* name) {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    shared.names.push_back(name);
+    return shared.names.size() - 1;
+}
+
+uint64_t Profiler::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Increments a counter of the calling thread; no synchronization is involved.
+ */
+
+void Profiler::count(size_t event) { ++threadProfile().entry(event).calls; }
+
+/**
+ * @brief Accumulates one execution of a timed scope in the calling thread's table and, when a
+ * trace file is requested, appends it to the thread's trace.
+ */
+
+void Profiler::record(size_t event, uint64_t startNanoseconds, uint64_t durationNanoseconds) {
+    ThreadProfile& profile = threadProfile();
+    ProfileEntry& entry = profile.entry(event);
+
+    ++entry.calls;
+    entry.totalNanoseconds += durationNanoseconds;
+    entry.minNanoseconds = std::min(entry.minNanoseconds, durationNanoseconds);
+    entry.maxNanoseconds = std::max(entry.maxNanoseconds, durationNanoseconds);
+
+    if (profile.tracing && profile.trace.size() < maxTraceEventsPerThread)
+        profile.trace.push_back({ event, startNanoseconds, durationNanoseconds });
+}
+
+/**
+ * @brief Writes the per-event totals of the threads that have finished, which at exit are all of them.
+ *
+ * Counters only have a number of calls; timed scopes also have their total, mean, minimum and
+ * maximum durations.
+ */
+
+void Profiler::writeSummary(std::ostream& os) {
+    Registry& shared = registry();
+
+    os << "\nProfile (" << shared.numberOfThreads << " threads)\n"
+       << std::left << std::setw(40) << "event" << std::right << std::setw(10) << "threads"
+       << std::setw(14) << "calls" << std::setw(14) << "total(ms)" << std::setw(14) << "mean(us)"
+       << std::setw(14) << "min(us)" << std::setw(14) << "max(us)" << std::endl;
+
+    for (size_t i = 0; i < shared.totals.size(); ++i) {
+        const ProfileEntry& entry = shared.totals[i];
+        if (entry.calls == 0)
+            continue;
+
+        os << std::left << std::setw(40) << shared.names[i] << std::right << std::setw(10)
+           << shared.threadsPerEvent[i] << std::setw(14) << entry.calls;
+
+        if (entry.totalNanoseconds > 0)
+            os << std::fixed << std::setprecision(3) << std::setw(14) << entry.totalNanoseconds / 1e6
+               << std::setw(14) << entry.totalNanoseconds / 1e3 / entry.calls
+               << std::setw(14) << entry.minNanoseconds / 1e3 << std::setw(14) << entry.maxNanoseconds / 1e3;
+
+        os << std::endl;
+    }
+}
+
+/**
+ * @brief Writes the recorded scopes in the Chrome trace event format (chrome://tracing, Perfetto).
+ */
+
+void Profiler::writeChromeTrace(const std::string& filename) {
+    Registry& shared = registry();
+    std::ofstream file(filename);
+    bool first = true;
+
+    file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[\n";
+
+    for (const auto& thread: shared.traces) {
+        for (const auto& event: thread.second) {
+            file << (first ? "" : ",\n") << "{\"name\":\"" << shared.names[event.event]
+                 << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.first
+                 << ",\"ts\":" << (event.startNanoseconds - shared.origin) / 1e3
+                 << ",\"dur\":" << event.durationNanoseconds / 1e3 << "}";
+            first = false;
+        }
+    }
+
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
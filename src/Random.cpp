@@ -0,0 +1,39 @@
+#include "Random.hpp"
+#include <cstdlib>
+#include <string>
+
+/**
+ * @brief Returns the random number engine of the calling thread.
+ *
+ * Every thread owns one engine, seeded from std::random_device on first use unless
+ * Random::seed is called, so runs are reproducible when a seed is given.
+ *
+ * @return std::mt19937& The engine of the calling thread.
+ */
+
+std::mt19937& Random::engine() {
+    thread_local std::mt19937 generator(std::random_device{}());
+    return generator;
+}
+
+/**
+ * @brief Seeds the random number engine of the calling thread.
+ *
+ * @param value The seed.
+ */
+
+void Random::seed(unsigned int value) { engine().seed(value); }
+
+/**
+ * @brief Seeds the random number engine of the calling thread from DRD_SEED, or from
+ * std::random_device when it is unset, so the seed of a run can be recorded and replayed.
+ *
+ * @return unsigned int The seed.
+ */
+
+unsigned int Random::seedFromEnvironment() {
+    const char* value = std::getenv("DRD_SEED");
+    unsigned int seed = value ? std::stoul(value) : std::random_device{}();
+    Random::seed(seed);
+    return seed;
+}
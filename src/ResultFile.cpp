@@ -0,0 +1,665 @@
+#include "ResultFile.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+constexpr uint32_t magic = 0x52445244; // "DRDR"
+constexpr uint32_t version = 1;
+constexpr uint32_t directedFlag = 1;
+constexpr uint32_t weightedFlag = 2;
+constexpr uint32_t noWitness = std::numeric_limits<uint32_t>::max();
+
+void writeJsonString(OutputBuffer& output, const std::string& text) {
+    output.put('"');
+    for (const auto& character: text) {
+        if ((character == '"') || (character == '\\')) {
+            output.put('\\');
+            output.put(character);
+        }
+        else if (static_cast<unsigned char>(character) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", character);
+            output.write(escaped, 6);
+        }
+        else
+            output.put(character);
+    }
+    output.put('"');
+}
+
+void writeBinaryString(OutputBuffer& output, const std::string& text) {
+    output.writeBytes<uint64_t>(text.size());
+    output.write(text);
+}
+
+/**
+ * Reads the JSON written by ResultWriter: a recursive descent over the text that converts the
+ * values it is asked for and skips the others.
+ */
+
+class JsonCursor {
+    private:
+        const std::string& path;
+        const std::string& text;
+        size_t offset;
+
+    public:
+        JsonCursor(const std::string& path, const std::string& text) : path(path), text(text), offset(0) {}
+
+        [[noreturn]] void fail(const std::string& reason) const {
+            throw std::runtime_error("Invalid result file " + this->path + ": " + reason + " at byte "
+                                     + std::to_string(this->offset));
+        }
+
+        char peek() {
+            while ((this->offset < this->text.size()) && std::isspace(static_cast<unsigned char>(this->text[this->offset])))
+                ++this->offset;
+            if (this->offset == this->text.size())
+                this->fail("unexpected end");
+            return this->text[this->offset];
+        }
+
+        void expect(char character) {
+            if (this->peek() != character)
+                this->fail(std::string("expected '") + character + "'");
+            ++this->offset;
+        }
+
+        bool next(char close) {
+            char character = this->peek();
+            if (character == close) {
+                ++this->offset;
+                return false;
+            }
+            if (character == ',')
+                ++this->offset;
+            return true;
+        }
+
+        std::string readString() {
+            std::string value;
+            this->expect('"');
+
+            while ((this->offset < this->text.size()) && (this->text[this->offset] != '"')) {
+                char character = this->text[this->offset++];
+                if ((character == '\\') && (this->offset < this->text.size())) {
+                    char escaped = this->text[this->offset++];
+                    if (escaped == 'u') {
+                        if (this->offset + 4 > this->text.size())
+                            this->fail("truncated escape");
+                        character = static_cast<char>(std::strtol(this->text.substr(this->offset, 4).c_str(), nullptr, 16));
+                        this->offset += 4;
+                    }
+                    else
+                        character = escaped == 'n' ? '\n' : escaped == 't' ? '\t' : escaped;
+                }
+                value.push_back(character);
+            }
+
+            this->expect('"');
+            return value;
+        }
+
+        size_t readUnsigned() {
+            this->peek();
+            size_t value = 0;
+            auto parsed = std::from_chars(this->text.data() + this->offset, this->text.data() + this->text.size(), value);
+            if (parsed.ec != std::errc())
+                this->fail("expected an unsigned integer");
+            this->offset = parsed.ptr - this->text.data();
+            return value;
+        }
+
+        double readDecimal() {
+            this->peek();
+            char* end = nullptr;
+            double value = std::strtod(this->text.c_str() + this->offset, &end);
+            if (end == this->text.c_str() + this->offset)
+                this->fail("expected a number");
+            this->offset = end - this->text.c_str();
+            return value;
+        }
+
+        bool readBool() {
+            this->peek();
+            if (this->text.compare(this->offset, 4, "true") == 0) {
+                this->offset += 4;
+                return true;
+            }
+            if (this->text.compare(this->offset, 5, "false") == 0) {
+                this->offset += 5;
+                return false;
+            }
+            this->fail("expected a boolean");
+        }
+
+        void skipValue() {
+            char character = this->peek();
+
+            if (character == '"')
+                this->readString();
+            else if ((character == '{') || (character == '[')) {
+                char close = character == '{' ? '}' : ']';
+                ++this->offset;
+                while (this->next(close)) {
+                    if (close == '}') {
+                        this->readString();
+                        this->expect(':');
+                    }
+                    this->skipValue();
+                }
+            }
+            else {
+                while ((this->offset < this->text.size()) && !std::strchr(",]} \t\r\n", this->text[this->offset]))
+                    ++this->offset;
+            }
+        }
+};
+
+}
+
+OutputBuffer::OutputBuffer(std::FILE* file, size_t capacity) : file(file), bytes(capacity), used(0), failed(false) {}
+
+OutputBuffer::~OutputBuffer() { this->flush(); }
+
+void OutputBuffer::write(const char* data, size_t length) {
+    if (length > this->bytes.size() - this->used) {
+        this->flush();
+        if (length > this->bytes.size()) {
+            this->failed = this->failed || (std::fwrite(data, 1, length, this->file) != length);
+            return;
+        }
+    }
+
+    std::memcpy(this->bytes.data() + this->used, data, length);
+    this->used += length;
+}
+
+void OutputBuffer::write(const std::string& text) { this->write(text.data(), text.size()); }
+
+void OutputBuffer::writeInteger(long long value) {
+    char digits[24];
+    auto converted = std::to_chars(digits, digits + sizeof(digits), value);
+    this->write(digits, converted.ptr - digits);
+}
+
+void OutputBuffer::writeDecimal(double value) {
+    char digits[32];
+    int length = std::snprintf(digits, sizeof(digits), "%.3f", value);
+    this->write(digits, std::min<size_t>(length, sizeof(digits) - 1));
+}
+
+/**
+ * @brief Hands the buffered bytes to the stream and flushes it.
+ *
+ * @return false if any write since the buffer was created has failed.
+ */
+
+bool OutputBuffer::flush() {
+    if (this->used > 0)
+        this->failed = this->failed || (std::fwrite(this->bytes.data(), 1, this->used, this->file) != this->used);
+    this->used = 0;
+    this->failed = this->failed || (std::fflush(this->file) != 0);
+    return !this->failed;
+}
+
+/**
+ * @brief Starts the result of a run.
+ *
+ * @param graph The graph that was solved, in the vertex ids the labelings will use. It must
+ *        outlive the writer.
+ * @param graphPath The file the graph was read from, recorded for the verify tool.
+ * @param seed The seed of the run.
+ * @param lowerBound The lower bound on γ2R of the run.
+ */
+
+ResultWriter::ResultWriter(const Graph& graph, const std::string& graphPath, uint64_t seed, size_t lowerBound)
+    : graph(graph) {
+    this->result.graphPath = graphPath;
+    this->result.order = graph.getOrder();
+    this->result.size = graph.getSize();
+    this->result.directed = graph.isDirectedGraph();
+    this->result.weighted = graph.isWeightedGraph();
+    this->result.lowerBound = lowerBound;
+    this->result.seed = seed;
+}
+
+/**
+ * @brief Adds the solution of an engine, with its weight and certificate.
+ *
+ * @throws std::invalid_argument if the labeling does not give every vertex of the graph a label
+ *         from 0 to 3.
+ */
+
+void ResultWriter::add(const std::string& engine, const std::vector<int>& labels, double milliseconds) {
+    if (labels.size() != this->result.order)
+        throw std::invalid_argument("The solution of " + engine + " must label every vertex of the graph");
+    for (const auto& label: labels)
+        if ((label < 0) || (label > 3))
+            throw std::invalid_argument("The solution of " + engine + " has a label outside 0 to 3");
+
+    EngineResult entry;
+    entry.engine = engine;
+    entry.gamma2r = this->graph.getWeight(labels);
+    entry.milliseconds = milliseconds;
+    entry.labels = labels;
+    entry.certificate = certify(this->graph, labels);
+    this->result.engines.push_back(std::move(entry));
+}
+
+/**
+ * @brief Writes the result to a file, as JSON when the path ends in ".json" and in the binary
+ * format otherwise.
+ *
+ * The binary format is, in native byte order: the magic number "DRDR", the format version and
+ * flags (1 directed, 2 weighted) as 32-bit words; order, size, lower bound and seed as 64-bit
+ * words; the graph path; the number of engines and, per engine, its name, γ2R, milliseconds (a
+ * double), its labels packed four per byte (vertex v in bits 2(v mod 4) of byte v / 4) and its
+ * certificate entries as three 32-bit words each, missing witnesses being 0xffffffff. Strings and
+ * arrays are preceded by their 64-bit length.
+ *
+ * @throws std::runtime_error if the file cannot be written, or for the binary format if the graph
+ *         has 2^32 - 1 vertices or more.
+ */
+
+void ResultWriter::write(const std::string& path) const {
+    ResultFormat format = formatOf(path);
+    if ((format == ResultFormat::Binary) && (this->result.order >= noWitness))
+        throw std::runtime_error("The binary result format holds graphs of less than 2^32 - 1 vertices");
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        throw std::runtime_error("Cannot write result " + path);
+
+    bool written = false;
+    {
+        OutputBuffer output(file, 1 << 20);
+        if (format == ResultFormat::Json)
+            this->writeJson(output);
+        else
+            this->writeBinary(output);
+        written = output.flush();
+    }
+
+    if ((std::fclose(file) != 0) || !written)
+        throw std::runtime_error("Cannot write result " + path);
+}
+
+/**
+ * @brief The labels are written as a flat list of (label, run length) pairs and each certificate
+ * entry as [vertex, witnesses...].
+ */
+
+void ResultWriter::writeJson(OutputBuffer& output) const {
+    output.write("{\"format\":\"drd-result\",\"version\":");
+    output.writeInteger(version);
+    output.write(",\n\"graph\":{\"path\":");
+    writeJsonString(output, this->result.graphPath);
+    output.write(",\"order\":");
+    output.writeInteger(this->result.order);
+    output.write(",\"size\":");
+    output.writeInteger(this->result.size);
+    output.write(this->result.directed ? ",\"directed\":true" : ",\"directed\":false");
+    output.write(this->result.weighted ? ",\"weighted\":true}" : ",\"weighted\":false}");
+    output.write(",\n\"seed\":");
+    output.writeInteger(this->result.seed);
+    output.write(",\"lower_bound\":");
+    output.writeInteger(this->result.lowerBound);
+    output.write(",\n\"engines\":[");
+
+    for (size_t i = 0; i < this->result.engines.size(); ++i) {
+        const EngineResult& entry = this->result.engines[i];
+
+        output.write(i == 0 ? "\n{\"engine\":" : ",\n{\"engine\":");
+        writeJsonString(output, entry.engine);
+        output.write(",\"gamma2r\":");
+        output.writeInteger(entry.gamma2r);
+        output.write(",\"milliseconds\":");
+        output.writeDecimal(entry.milliseconds);
+        output.write(",\n\"labels\":{\"encoding\":\"run-length\",\"runs\":[");
+
+        for (size_t v = 0; v < entry.labels.size();) {
+            size_t run = v + 1;
+            while ((run < entry.labels.size()) && (entry.labels[run] == entry.labels[v]))
+                ++run;
+            if (v > 0)
+                output.put(',');
+            output.writeInteger(entry.labels[v]);
+            output.put(',');
+            output.writeInteger(run - v);
+            v = run;
+        }
+
+        output.write("]},\n\"certificate\":[");
+
+        for (size_t j = 0; j < entry.certificate.size(); ++j) {
+            if (j > 0)
+                output.put(',');
+            output.put('[');
+            output.writeInteger(entry.certificate[j][0]);
+            for (size_t k = 1; (k < 3) && (entry.certificate[j][k] != EngineResult::none); ++k) {
+                output.put(',');
+                output.writeInteger(entry.certificate[j][k]);
+            }
+            output.put(']');
+        }
+
+        output.write("]}");
+    }
+
+    output.write("\n]}\n");
+}
+
+void ResultWriter::writeBinary(OutputBuffer& output) const {
+    output.writeBytes(magic);
+    output.writeBytes(version);
+    output.writeBytes<uint32_t>((this->result.directed ? directedFlag : 0) | (this->result.weighted ? weightedFlag : 0));
+    output.writeBytes<uint64_t>(this->result.order);
+    output.writeBytes<uint64_t>(this->result.size);
+    output.writeBytes<uint64_t>(this->result.lowerBound);
+    output.writeBytes<uint64_t>(this->result.seed);
+    writeBinaryString(output, this->result.graphPath);
+    output.writeBytes<uint64_t>(this->result.engines.size());
+
+    std::vector<uint8_t> packed;
+
+    for (const auto& entry: this->result.engines) {
+        writeBinaryString(output, entry.engine);
+        output.writeBytes<uint64_t>(entry.gamma2r);
+        output.writeBytes<double>(entry.milliseconds);
+
+        packed.assign((entry.labels.size() + 3) / 4, 0);
+        for (size_t v = 0; v < entry.labels.size(); ++v)
+            packed[v / 4] |= static_cast<uint8_t>(entry.labels[v] << (2 * (v % 4)));
+        output.writeBytes<uint64_t>(packed.size());
+        output.write(reinterpret_cast<const char*>(packed.data()), packed.size());
+
+        output.writeBytes<uint64_t>(entry.certificate.size());
+        for (const auto& witnessed: entry.certificate)
+            for (const auto& vertex: witnessed)
+                output.writeBytes<uint32_t>(vertex == EngineResult::none ? noWitness : static_cast<uint32_t>(vertex));
+    }
+}
+
+const ResultFile& ResultWriter::getResult() const { return this->result; }
+
+/**
+ * @brief Finds the dominators of every vertex labeled 0 or 1 among its in-neighbors, preferring a
+ * single neighbor labeled 3 for a 0. O(n + m).
+ *
+ * @return The certificate entries, in increasing vertex order; on an infeasible labeling the
+ *         witnesses that could not be found are EngineResult::none.
+ */
+
+std::vector<std::array<size_t, 3>> ResultWriter::certify(const Graph& graph, const std::vector<int>& labels) {
+    std::vector<std::array<size_t, 3>> certificate;
+
+    for (size_t v = 0; v < labels.size(); ++v) {
+        if ((labels[v] != 0) && (labels[v] != 1))
+            continue;
+
+        std::array<size_t, 3> entry = { v, EngineResult::none, EngineResult::none };
+        size_t labeled2 = 0;
+
+        for (const auto& neighbor: graph.getInNeighbors(v)) {
+            int label = labels[neighbor];
+
+            if ((label == 3) || ((labels[v] == 1) && (label == 2))) {
+                entry = { v, neighbor, EngineResult::none };
+                break;
+            }
+            if ((label == 2) && (labeled2 < 2))
+                entry[1 + labeled2++] = neighbor;
+        }
+
+        certificate.push_back(entry);
+    }
+
+    return certificate;
+}
+
+ResultFormat ResultWriter::formatOf(const std::string& path) {
+    const std::string extension = ".json";
+    bool json = (path.size() >= extension.size()) && (path.compare(path.size() - extension.size(), extension.size(), extension) == 0);
+    return json ? ResultFormat::Json : ResultFormat::Binary;
+}
+
+/**
+ * @brief Prints a labeling as space-separated labels on one line, through an OutputBuffer.
+ */
+
+void ResultWriter::printLabels(const std::vector<int>& labels, std::FILE* file) {
+    OutputBuffer output(file);
+
+    for (const auto& label: labels) {
+        output.writeInteger(label);
+        output.put(' ');
+    }
+    output.put('\n');
+}
+
+/**
+ * @brief Reads a result file written by ResultWriter, in either format (told apart by the magic
+ * number of the binary one).
+ *
+ * @throws std::runtime_error if the file cannot be read or is not a valid result file.
+ */
+
+ResultFile ResultReader::read(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Cannot open result " + path);
+
+    std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    uint32_t head = 0;
+
+    if (bytes.size() >= sizeof(head))
+        std::memcpy(&head, bytes.data(), sizeof(head));
+    if (head == magic)
+        return readBinary(path, bytes);
+
+    return readJson(path, std::string(bytes.begin(), bytes.end()));
+}
+
+ResultFile ResultReader::readJson(const std::string& path, const std::string& text) {
+    ResultFile result;
+    JsonCursor cursor(path, text);
+    bool format = false;
+
+    cursor.expect('{');
+    while (cursor.next('}')) {
+        std::string key = cursor.readString();
+        cursor.expect(':');
+
+        if (key == "format")
+            format = cursor.readString() == "drd-result";
+        else if (key == "version") {
+            if (cursor.readUnsigned() != version)
+                cursor.fail("unsupported version");
+        }
+        else if (key == "seed")
+            result.seed = cursor.readUnsigned();
+        else if (key == "lower_bound")
+            result.lowerBound = cursor.readUnsigned();
+        else if (key == "graph") {
+            cursor.expect('{');
+            while (cursor.next('}')) {
+                std::string field = cursor.readString();
+                cursor.expect(':');
+                if (field == "path")
+                    result.graphPath = cursor.readString();
+                else if (field == "order")
+                    result.order = cursor.readUnsigned();
+                else if (field == "size")
+                    result.size = cursor.readUnsigned();
+                else if (field == "directed")
+                    result.directed = cursor.readBool();
+                else if (field == "weighted")
+                    result.weighted = cursor.readBool();
+                else
+                    cursor.skipValue();
+            }
+        }
+        else if (key == "engines") {
+            cursor.expect('[');
+            while (cursor.next(']')) {
+                EngineResult entry;
+                std::vector<std::pair<size_t, size_t>> runs;
+
+                cursor.expect('{');
+                while (cursor.next('}')) {
+                    std::string field = cursor.readString();
+                    cursor.expect(':');
+
+                    if (field == "engine")
+                        entry.engine = cursor.readString();
+                    else if (field == "gamma2r")
+                        entry.gamma2r = cursor.readUnsigned();
+                    else if (field == "milliseconds")
+                        entry.milliseconds = cursor.readDecimal();
+                    else if (field == "labels") {
+                        cursor.expect('{');
+                        while (cursor.next('}')) {
+                            std::string part = cursor.readString();
+                            cursor.expect(':');
+                            if (part == "encoding") {
+                                if (cursor.readString() != "run-length")
+                                    cursor.fail("unknown label encoding");
+                            }
+                            else if (part == "runs") {
+                                cursor.expect('[');
+                                while (cursor.next(']')) {
+                                    size_t label = cursor.readUnsigned();
+                                    cursor.expect(',');
+                                    runs.emplace_back(label, cursor.readUnsigned());
+                                }
+                            }
+                            else
+                                cursor.skipValue();
+                        }
+                    }
+                    else if (field == "certificate") {
+                        cursor.expect('[');
+                        while (cursor.next(']')) {
+                            std::array<size_t, 3> witnessed = { EngineResult::none, EngineResult::none, EngineResult::none };
+                            size_t count = 0;
+                            cursor.expect('[');
+                            while (cursor.next(']')) {
+                                if (count == 3)
+                                    cursor.fail("certificate entry with more than two witnesses");
+                                witnessed[count++] = cursor.readUnsigned();
+                            }
+                            if (count == 0)
+                                cursor.fail("empty certificate entry");
+                            entry.certificate.push_back(witnessed);
+                        }
+                    }
+                    else
+                        cursor.skipValue();
+                }
+
+                size_t total = 0;
+                for (const auto& run: runs) {
+                    if ((run.first > 3) || (run.second > result.order - total))
+                        cursor.fail("labels do not match the order of the graph");
+                    total += run.second;
+                }
+                for (const auto& run: runs)
+                    entry.labels.insert(entry.labels.end(), run.second, static_cast<int>(run.first));
+
+                result.engines.push_back(std::move(entry));
+            }
+        }
+        else
+            cursor.skipValue();
+    }
+
+    if (!format)
+        throw std::runtime_error(path + " is not a result file");
+
+    return result;
+}
+
+ResultFile ResultReader::readBinary(const std::string& path, const std::vector<char>& bytes) {
+    ResultFile result;
+    size_t offset = 0;
+
+    auto require = [&path, &bytes, &offset](size_t count, size_t length) {
+        if ((length > 0) && (count > (bytes.size() - offset) / length))
+            throw std::runtime_error("Truncated result file " + path);
+    };
+    auto read = [&bytes, &offset, &require](auto& value) {
+        require(1, sizeof(value));
+        std::memcpy(&value, bytes.data() + offset, sizeof(value));
+        offset += sizeof(value);
+    };
+    auto readString = [&bytes, &offset, &require, &read]() {
+        uint64_t length = 0;
+        read(length);
+        require(length, 1);
+        std::string text(bytes.data() + offset, length);
+        offset += length;
+        return text;
+    };
+
+    uint32_t head = 0, fileVersion = 0, flags = 0;
+    uint64_t order = 0, size = 0, lowerBound = 0, engines = 0;
+    read(head);
+    read(fileVersion);
+    if (fileVersion != version)
+        throw std::runtime_error(path + " is not a result file of this version");
+
+    read(flags);
+    read(order);
+    read(size);
+    read(lowerBound);
+    read(result.seed);
+    result.graphPath = readString();
+    read(engines);
+
+    result.order = order;
+    result.size = size;
+    result.lowerBound = lowerBound;
+    result.directed = (flags & directedFlag) != 0;
+    result.weighted = (flags & weightedFlag) != 0;
+
+    for (uint64_t i = 0; i < engines; ++i) {
+        EngineResult entry;
+        uint64_t gamma2r = 0, packedSize = 0, entries = 0;
+
+        entry.engine = readString();
+        read(gamma2r);
+        read(entry.milliseconds);
+        entry.gamma2r = gamma2r;
+
+        read(packedSize);
+        if (packedSize != (order + 3) / 4)
+            throw std::runtime_error("Invalid result file " + path + ": labels do not match the order of the graph");
+        require(packedSize, 1);
+        entry.labels.resize(order);
+        for (size_t v = 0; v < order; ++v)
+            entry.labels[v] = (static_cast<uint8_t>(bytes[offset + v / 4]) >> (2 * (v % 4))) & 3;
+        offset += packedSize;
+
+        read(entries);
+        require(entries, 3 * sizeof(uint32_t));
+        entry.certificate.resize(entries);
+        for (auto& witnessed: entry.certificate)
+            for (auto& vertex: witnessed) {
+                uint32_t value = 0;
+                read(value);
+                vertex = value == noWitness ? EngineResult::none : value;
+            }
+
+        result.engines.push_back(std::move(entry));
+    }
+
+    return result;
+}
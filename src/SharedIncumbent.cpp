@@ -0,0 +1,45 @@
+#include "SharedIncumbent.hpp"
+
+/**
+ * @brief Publishes `solution` if it is lighter than the shared incumbent.
+ *
+ * The slot is replaced with a compare-and-swap on the shared pointer, so the lightest of
+ * concurrent offers wins and readers keep the solution they loaded alive. Offers that cannot
+ * improve are rejected after one atomic load of the weight, without allocating.
+ *
+ * @param solution A feasible solution.
+ * @param weight Its weight.
+ * @param source The algorithm offering it.
+ * @return bool True if the solution became the incumbent.
+ */
+
+bool SharedIncumbent::offer(const std::vector<int>& solution, size_t weight, IncumbentSource source) {
+    if (weight >= this->weight.load(std::memory_order_acquire))
+        return false;
+
+    auto candidate = std::make_shared<const IncumbentSolution>(IncumbentSolution{ solution, weight, source });
+    std::shared_ptr<const IncumbentSolution> current = std::atomic_load(&this->slot);
+
+    do {
+        if (current && current->weight <= weight)
+            return false;
+    } while (!std::atomic_compare_exchange_weak(&this->slot, &current, candidate));
+
+    size_t published = this->weight.load(std::memory_order_relaxed);
+    while ((weight < published) &&
+           !this->weight.compare_exchange_weak(published, weight, std::memory_order_release));
+
+    return true;
+}
+
+/**
+ * @brief Returns the current incumbent, or a null pointer if nothing has been offered yet.
+ */
+
+std::shared_ptr<const IncumbentSolution> SharedIncumbent::load() const { return std::atomic_load(&this->slot); }
+
+/**
+ * @brief Weight of the current incumbent, read without touching the slot; the maximum size_t when empty.
+ */
+
+size_t SharedIncumbent::getWeight() const { return this->weight.load(std::memory_order_acquire); }
@@ -0,0 +1,243 @@
+#include "TabuSearch.hpp"
+#include "LocalSearch.hpp"
+#include "Profiler.hpp"
+#include "Random.hpp"
+#include <chrono>
+#include <stdexcept>
+
+/**
+ * @brief Prepares a tabu search on a graph.
+ *
+ * @param graph The graph to solve. It must outlive the search.
+ * @param settings Iteration limits, tabu tenure and the period of the penalty adaptation.
+ */
+
+TabuSearch::TabuSearch(const Graph& graph, const TabuSettings& settings)
+    : graph(graph), settings(settings), lowerBound(0), bestWeight(std::numeric_limits<size_t>::max()) {}
+
+/**
+ * @brief Searches for a light double Roman dominating function starting from a labeling.
+ *
+ * Every iteration applies the best move that is not tabu, scanning a table that holds, for every
+ * vertex and label, the change in undominated vertices of that relabel. A relabel of v only changes
+ * the label of v and the counters of its out-neighbors w, so the table is kept exact by subtracting
+ * and re-adding the terms that v and each w contribute to the moves of their in-neighbors, O(1)
+ * each, and by recomputing the row of v. Relabeled vertices stay tabu for `tenure` plus a random
+ * number of iterations up to `tenureRange`, unless the move gives a feasible labeling lighter than
+ * the best one (aspiration). Ties are broken at random.
+ *
+ * The search stops after `iterations` iterations, `stallIterations` without a new best (0 never),
+ * `timeBudget` seconds (0 never) or at the lower bound. The best labeling is finally polished by LocalSearch.
+ *
+ * @param initialSolution A labeling of every vertex, e.g. a construction heuristic's; it need not
+ *        be feasible, and unlabeled vertices (-1) start at 0.
+ * @return size_t The weight of the best double Roman dominating function found.
+ * @throws std::invalid_argument if the labeling does not match the order of the graph.
+ */
+
+size_t TabuSearch::run(const std::vector<int>& initialSolution) {
+    PROFILE_SCOPE("TabuSearch::run");
+    size_t order = this->graph.getOrder();
+
+    if (initialSolution.size() != order)
+        throw std::invalid_argument("The initial solution must label every vertex of the graph");
+
+    std::vector<int> labels(initialSolution);
+    size_t minCost = std::numeric_limits<size_t>::max(), maxCost = 1;
+
+    for (size_t v = 0; v < order; ++v) {
+        if (!this->graph.vertexExists(v))
+            continue;
+        labels[v] = std::max(labels[v], 0);
+        minCost = std::min(minCost, this->graph.getCost(v));
+        maxCost = std::max(maxCost, this->graph.getCost(v));
+    }
+
+    DominationState state(this->graph, labels);
+    size_t undominated = 0;
+
+    this->deltas.assign(order, { 0, 0, 0, 0 });
+    this->tabuUntil.assign(order, 0);
+    this->bestSolution.clear();
+    this->bestWeight = std::numeric_limits<size_t>::max();
+    this->statistics = TabuStatistics();
+
+    for (size_t v = 0; v < order; ++v) {
+        if (!this->graph.vertexExists(v))
+            continue;
+        undominated += state.isDominated(v) ? 0 : 1;
+        this->evaluate(state, v);
+    }
+
+    if (undominated == 0) {
+        this->bestSolution = state.getLabels();
+        this->bestWeight = state.getWeight();
+    }
+
+    double penalty = 2.0 * maxCost + 1.0;
+    double minPenalty = std::min(minCost, maxCost);
+    size_t lastImprovement = 0, feasibleRun = 0, infeasibleRun = 0;
+    std::mt19937& engine = Random::engine();
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t iteration = 1; iteration <= this->settings.iterations; ++iteration) {
+        if (this->bestWeight <= this->lowerBound)
+            break;
+        if ((this->settings.timeBudget > 0.0)
+            && (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= this->settings.timeBudget))
+            break;
+        if ((this->settings.stallIterations > 0) && (iteration - lastImprovement > this->settings.stallIterations))
+            break;
+
+        size_t chosen = none, fallback = none;
+        int chosenLabel = 0, fallbackLabel = 0;
+        double chosenScore = 0.0, fallbackScore = 0.0;
+        size_t ties = 0;
+        bool aspirated = false;
+
+        for (size_t v = 0; v < order; ++v) {
+            if (!this->graph.vertexExists(v))
+                continue;
+
+            int label = state.getLabel(v);
+            long long cost = this->graph.getCost(v);
+            bool tabu = this->tabuUntil[v] >= iteration;
+
+            for (int candidate = 0; candidate <= 3; ++candidate) {
+                if (candidate == label)
+                    continue;
+
+                long long weightDelta = (candidate - label) * cost;
+                int undominatedDelta = this->deltas[v][candidate];
+                double score = weightDelta + penalty * undominatedDelta;
+
+                if (tabu) {
+                    bool aspiration = (static_cast<long long>(undominated) + undominatedDelta == 0)
+                                      && (static_cast<long long>(state.getWeight()) + weightDelta
+                                          < static_cast<long long>(this->bestWeight));
+                    if (!aspiration) {
+                        if ((fallback == none) || (score < fallbackScore)) {
+                            fallback = v;
+                            fallbackLabel = candidate;
+                            fallbackScore = score;
+                        }
+                        continue;
+                    }
+                }
+
+                if ((chosen == none) || (score < chosenScore)) {
+                    chosen = v;
+                    chosenLabel = candidate;
+                    chosenScore = score;
+                    ties = 1;
+                    aspirated = tabu;
+                }
+                else if ((score == chosenScore) && (engine() % ++ties == 0)) {
+                    chosen = v;
+                    chosenLabel = candidate;
+                    aspirated = tabu;
+                }
+            }
+        }
+
+        if (chosen == none) {
+            if (fallback == none)
+                break;
+            chosen = fallback;
+            chosenLabel = fallbackLabel;
+        }
+
+        undominated += this->deltas[chosen][chosenLabel];
+        this->adjustAround(state, chosen, -1);
+        state.setLabel(chosen, chosenLabel);
+        this->adjustAround(state, chosen, 1);
+        this->evaluate(state, chosen);
+
+        this->tabuUntil[chosen] = iteration + this->settings.tenure + engine() % (this->settings.tenureRange + 1);
+        this->statistics.iterations = iteration;
+        this->statistics.aspirations += aspirated ? 1 : 0;
+
+        if ((undominated == 0) && (state.getWeight() < this->bestWeight)) {
+            this->bestSolution = state.getLabels();
+            this->bestWeight = state.getWeight();
+            lastImprovement = iteration;
+            ++this->statistics.improvements;
+        }
+
+        if (undominated > 0) {
+            ++this->statistics.infeasibleIterations;
+            feasibleRun = 0;
+            if (++infeasibleRun == this->settings.penaltyPeriod) {
+                penalty *= 1.5;
+                infeasibleRun = 0;
+            }
+        }
+        else {
+            infeasibleRun = 0;
+            if (++feasibleRun == this->settings.penaltyPeriod) {
+                penalty = std::max(penalty / 1.5, minPenalty);
+                feasibleRun = 0;
+            }
+        }
+    }
+
+    if (!this->bestSolution.empty())
+        this->bestWeight = LocalSearch(this->graph).improve(this->bestSolution);
+
+    return this->bestWeight;
+}
+
+/**
+ * @brief Recomputes the row of the delta table of a vertex, O(deg) per label.
+ */
+
+void TabuSearch::evaluate(const DominationState& state, size_t vertex) {
+    int label = state.getLabel(vertex);
+
+    for (int candidate = 0; candidate <= 3; ++candidate)
+        this->deltas[vertex][candidate] = candidate == label ? 0 : state.undominatedDelta(vertex, candidate);
+}
+
+/**
+ * @brief Subtracts (sign -1) or adds (sign 1) the terms that a vertex v and its out-neighbors
+ * contribute to the delta table rows of the other vertices; called around a relabel of v, whose own
+ * row is recomputed afterwards.
+ */
+
+void TabuSearch::adjustAround(const DominationState& state, size_t vertex, int sign) {
+    auto adjust = [this, &state, vertex, sign](size_t observer) {
+        if (observer != vertex) {
+            int label = state.getLabel(observer);
+            for (int candidate = 0; candidate <= 3; ++candidate)
+                if (candidate != label)
+                    this->deltas[observer][candidate] += sign * state.undominatedDeltaAt(observer, observer, candidate);
+        }
+
+        for (const auto& mover: this->graph.getInNeighbors(observer)) {
+            if ((mover == vertex) || (mover == observer))
+                continue;
+
+            int label = state.getLabel(mover);
+            for (int candidate = 0; candidate <= 3; ++candidate)
+                if (candidate != label)
+                    this->deltas[mover][candidate] += sign * state.undominatedDeltaAt(observer, mover, candidate);
+        }
+    };
+
+    adjust(vertex);
+    for (const auto& neighbor: this->graph.getAdjacencyList(vertex))
+        adjust(neighbor);
+}
+
+/**
+ * @brief Sets a lower bound on the weight, e.g. DominationBounds::lowerBound; the search stops once
+ * it finds a solution of that weight.
+ */
+
+void TabuSearch::setLowerBound(size_t lowerBound) { this->lowerBound = lowerBound; }
+
+const std::vector<int>& TabuSearch::getBestSolution() const { return this->bestSolution; }
+
+size_t TabuSearch::getBestWeight() const { return this->bestWeight; }
+
+const TabuStatistics& TabuSearch::getStatistics() const { return this->statistics; }
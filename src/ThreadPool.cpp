@@ -0,0 +1,203 @@
+#include "ThreadPool.hpp"
+#include <limits>
+
+namespace {
+
+constexpr size_t noWorker = std::numeric_limits<size_t>::max();
+
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentWorker = noWorker;
+
+}
+
+/**
+ * @brief Starts a work-stealing pool.
+ *
+ * Every worker owns a deque: it pops its own tasks from the back (most recently pushed, still hot
+ * in cache) and, when it runs dry, steals from the front of the others' deques (the oldest tasks,
+ * usually the largest pieces of work), trying the workers of its own NUMA node first.
+ *
+ * With an affinity policy, workers are spread round-robin over the NUMA nodes and each one binds
+ * itself to its node (Node) or to one CPU of it (Core) before running any task, so the buffers a
+ * task allocates (populations, ant scratch, graph copies) are first touched, hence placed, on the
+ * node of the worker that keeps using them. A worker the kernel refuses to bind runs unbound.
+ *
+ * @param numberOfThreads Number of workers; 0 uses std::thread::hardware_concurrency().
+ * @param affinity Where the workers run; None leaves them to the scheduler.
+ */
+
+ThreadPool::ThreadPool(size_t numberOfThreads, AffinityPolicy affinity)
+    : affinity(affinity), pendingTasks(0), queuedTasks(0), nextQueue(0), steals(0), stopping(false) {
+    if (numberOfThreads == 0)
+        numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t i = 0; i < numberOfThreads; ++i)
+        this->queues.emplace_back(new WorkerQueue());
+
+    this->placeWorkers();
+
+    for (size_t i = 0; i < numberOfThreads; ++i)
+        this->workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+/**
+ * @brief Runs the remaining tasks, then stops the workers.
+ */
+
+ThreadPool::~ThreadPool() {
+    this->wait();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+
+    this->taskAvailable.notify_all();
+    for (auto& worker: this->workers)
+        worker.join();
+}
+
+/**
+ * @brief Queues a task.
+ *
+ * A task submitted from a worker of this pool goes to that worker's deque, so tasks spawned by a
+ * task stay local unless another worker is idle; other tasks are spread round-robin.
+ */
+
+void ThreadPool::submit(std::function<void()> task) {
+    size_t index = (currentPool == this) ? currentWorker
+                 : this->nextQueue.fetch_add(1, std::memory_order_relaxed) % this->queues.size();
+
+    ++this->pendingTasks;
+
+    {
+        std::lock_guard<std::mutex> lock(this->queues[index]->mutex);
+        this->queues[index]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        ++this->queuedTasks;
+    }
+
+    this->taskAvailable.notify_one();
+}
+
+/**
+ * @brief Blocks until every submitted task, including the ones submitted by tasks, has run.
+ */
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->allDone.wait(lock, [this]() { return this->pendingTasks == 0; });
+}
+
+size_t ThreadPool::getNumberOfThreads() const { return this->workers.size(); }
+
+/**
+ * @brief Number of tasks run by a worker other than the one they were queued on.
+ */
+
+size_t ThreadPool::getNumberOfSteals() const { return this->steals; }
+
+/**
+ * @brief NUMA node a worker is placed on; 0 for every worker without an affinity policy.
+ */
+
+size_t ThreadPool::getWorkerNode(size_t worker) const { return this->workerNodes.at(worker); }
+
+/**
+ * @brief Index of the pool worker running the calling thread, or the maximum size_t outside a pool.
+ */
+
+size_t ThreadPool::getCurrentWorker() { return currentWorker; }
+
+/**
+ * @brief Assigns worker i to node i mod (number of nodes) and orders the victims of every worker:
+ * the other workers of its node first, then the rest, each group starting after the worker itself.
+ */
+
+void ThreadPool::placeWorkers() {
+    size_t numberOfWorkers = this->queues.size();
+    size_t numberOfNodes = this->affinity == AffinityPolicy::None ? 1 : Topology::get().getNumberOfNodes();
+
+    this->workerNodes.assign(numberOfWorkers, 0);
+    for (size_t i = 0; i < numberOfWorkers; ++i)
+        this->workerNodes[i] = i % numberOfNodes;
+
+    this->victims.assign(numberOfWorkers, std::vector<size_t>());
+    for (size_t i = 0; i < numberOfWorkers; ++i) {
+        for (size_t j = 1; j < numberOfWorkers; ++j)
+            if (this->workerNodes[(i + j) % numberOfWorkers] == this->workerNodes[i])
+                this->victims[i].push_back((i + j) % numberOfWorkers);
+        for (size_t j = 1; j < numberOfWorkers; ++j)
+            if (this->workerNodes[(i + j) % numberOfWorkers] != this->workerNodes[i])
+                this->victims[i].push_back((i + j) % numberOfWorkers);
+    }
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentWorker = index;
+
+    if (this->affinity == AffinityPolicy::Node)
+        Topology::bindToNode(this->workerNodes[index]);
+    else if (this->affinity == AffinityPolicy::Core) {
+        const std::vector<size_t>& cpus = Topology::get().getCpus(this->workerNodes[index]);
+        size_t numberOfNodes = Topology::get().getNumberOfNodes();
+        Topology::bindToCpu(cpus[(index / numberOfNodes) % cpus.size()]);
+    }
+
+    std::function<void()> task;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->taskAvailable.wait(lock, [this]() { return this->stopping || (this->queuedTasks > 0); });
+
+            if (this->queuedTasks == 0)
+                return;
+
+            --this->queuedTasks;
+        }
+
+        // While a reservation is held, at least one unclaimed task is queued, so the scan ends.
+        while (!this->popTask(index, task) && !this->stealTask(index, task)) {}
+
+        task();
+        task = nullptr;
+
+        if (--this->pendingTasks == 0) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->allDone.notify_all();
+        }
+    }
+}
+
+bool ThreadPool::popTask(size_t index, std::function<void()>& task) {
+    WorkerQueue& queue = *this->queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.tasks.empty())
+        return false;
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::stealTask(size_t index, std::function<void()>& task) {
+    for (const auto& i: this->victims[index]) {
+        WorkerQueue& victim = *this->queues[i];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            ++this->steals;
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,190 @@
+#include "Topology.hpp"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+thread_local size_t boundNode = Topology::none;
+
+}
+
+/**
+ * @brief Reads the NUMA nodes and their CPUs from /sys/devices/system/node, keeping only the CPUs
+ * the process may run on (sched_getaffinity) and the nodes left with at least one of them. Without
+ * NUMA information (no sysfs, or a kernel built without NUMA) every allowed CPU forms one node.
+ */
+
+Topology::Topology() {
+    std::vector<size_t> allowed;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            if (CPU_ISSET(cpu, &set))
+                allowed.push_back(cpu);
+    }
+
+    if (allowed.empty())
+        allowed.push_back(0);
+
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string nodes;
+    std::getline(online, nodes);
+
+    for (const auto& node: parseCpuList(nodes)) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string list;
+        std::getline(file, list);
+        std::vector<size_t> cpus;
+
+        for (const auto& cpu: parseCpuList(list))
+            if (std::binary_search(allowed.begin(), allowed.end(), cpu))
+                cpus.push_back(cpu);
+
+        if (!cpus.empty())
+            this->nodeCpus.push_back(cpus);
+    }
+
+    if (this->nodeCpus.empty())
+        this->nodeCpus.push_back(allowed);
+
+    this->cpuNodes.assign(allowed.back() + 1, 0);
+    for (size_t node = 0; node < this->nodeCpus.size(); ++node)
+        for (const auto& cpu: this->nodeCpus[node])
+            this->cpuNodes[cpu] = node;
+}
+
+/**
+ * @brief The topology of the machine, read on first use.
+ */
+
+const Topology& Topology::get() {
+    static const Topology topology;
+    return topology;
+}
+
+size_t Topology::getNumberOfNodes() const { return this->nodeCpus.size(); }
+
+size_t Topology::getNumberOfCpus() const {
+    size_t cpus = 0;
+    for (const auto& node: this->nodeCpus)
+        cpus += node.size();
+    return cpus;
+}
+
+const std::vector<size_t>& Topology::getCpus(size_t node) const { return this->nodeCpus.at(node); }
+
+/**
+ * @brief Node of a CPU; 0 for CPUs outside the process's affinity mask.
+ */
+
+size_t Topology::getNode(size_t cpu) const { return cpu < this->cpuNodes.size() ? this->cpuNodes[cpu] : 0; }
+
+/**
+ * @brief Node the calling thread runs on: the node it was bound to, or the node of the CPU it is
+ * running on right now (sched_getcpu), which may change unless the thread is bound.
+ */
+
+size_t Topology::getCurrentNode() {
+    if (boundNode != none)
+        return boundNode;
+
+    int cpu = sched_getcpu();
+    return cpu < 0 ? 0 : get().getNode(cpu);
+}
+
+/**
+ * @brief Node the calling thread was bound to by bindToNode() or bindToCpu(), or `none`. Threads
+ * spawned by a bound thread inherit its CPU mask but not this value, so they should bind to it
+ * themselves; a thread bound to one CPU would otherwise share it with everything it spawns.
+ */
+
+size_t Topology::getBoundNode() { return boundNode; }
+
+/**
+ * @brief Restricts the calling thread to the CPUs of a node (pthread_setaffinity_np).
+ *
+ * @return false, leaving the thread unbound, if the node does not exist or the kernel refused.
+ */
+
+bool Topology::bindToNode(size_t node) {
+    const Topology& topology = get();
+    if (node >= topology.getNumberOfNodes())
+        return false;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const auto& cpu: topology.getCpus(node))
+        CPU_SET(cpu, &set);
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+        return false;
+
+    boundNode = node;
+    return true;
+}
+
+/**
+ * @brief Restricts the calling thread to one CPU (pthread_setaffinity_np).
+ *
+ * @return false, leaving the thread unbound, if the kernel refused.
+ */
+
+bool Topology::bindToCpu(size_t cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+        return false;
+
+    boundNode = get().getNode(cpu);
+    return true;
+}
+
+/**
+ * @brief Parses "none", "node" or "core".
+ *
+ * @throws std::invalid_argument for any other name.
+ */
+
+AffinityPolicy Topology::parse(const std::string& name) {
+    if (name == "none")
+        return AffinityPolicy::None;
+    if (name == "node")
+        return AffinityPolicy::Node;
+    if (name == "core")
+        return AffinityPolicy::Core;
+
+    throw std::invalid_argument("Unknown affinity " + name);
+}
+
+/**
+ * @brief Parses a sysfs CPU or node list such as "0-3,8-11".
+ */
+
+std::vector<size_t> Topology::parseCpuList(const std::string& list) {
+    std::vector<size_t> cpus;
+    std::stringstream stream(list);
+    std::string range;
+
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || !std::isdigit(static_cast<unsigned char>(range[0])))
+            continue;
+
+        size_t dash = range.find('-');
+        size_t first = std::stoul(range.substr(0, dash));
+        size_t last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+
+        for (size_t cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(cpu);
+    }
+
+    return cpus;
+}
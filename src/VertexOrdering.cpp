@@ -0,0 +1,344 @@
+#include "VertexOrdering.hpp"
+#include <limits>
+#include <stdexcept>
+
+/**
+ * @brief Computes a relabeling of the vertices that places neighbors close to each other, so the
+ * per-vertex arrays of the algorithms (labels, pheromones, domination counters) are read with
+ * fewer cache misses.
+ *
+ *  - BFS: breadth-first order, components in order of their lowest vertex;
+ *  - ReverseCuthillMcKee: breadth-first order from a pseudo-peripheral vertex of each component,
+ *    neighbors by increasing degree, reversed, which keeps the bandwidth of the adjacency small;
+ *  - DegreeDescending: hubs first, so the most read entries share cache lines;
+ *  - Community: communities found by label propagation, each stored contiguously in breadth-first
+ *    order, and laid out in the order a breadth-first traversal reaches them (a simpler take on
+ *    Rabbit order, which builds the communities by modularity-driven aggregation).
+ *
+ * @param graph The graph, with vertices 0 to order - 1.
+ * @param strategy The ordering; OrderingStrategy::Identity keeps the ids.
+ */
+
+VertexOrdering::VertexOrdering(const Graph& graph, OrderingStrategy strategy) {
+    std::vector<std::vector<size_t>> adjacency = adjacencyOf(graph);
+    size_t order = adjacency.size();
+
+    switch (strategy) {
+        case OrderingStrategy::BFS:
+            this->newToOriginal = breadthFirstOrder(adjacency, false, false);
+            break;
+        case OrderingStrategy::ReverseCuthillMcKee:
+            this->newToOriginal = breadthFirstOrder(adjacency, true, true);
+            std::reverse(this->newToOriginal.begin(), this->newToOriginal.end());
+            break;
+        case OrderingStrategy::DegreeDescending:
+            this->newToOriginal = degreeOrder(adjacency);
+            break;
+        case OrderingStrategy::Community:
+            this->newToOriginal = communityOrder(adjacency);
+            break;
+        default:
+            this->newToOriginal.resize(order);
+            for (size_t i = 0; i < order; ++i)
+                this->newToOriginal[i] = i;
+    }
+
+    this->originalToNew.resize(order);
+    for (size_t i = 0; i < order; ++i)
+        this->originalToNew[this->newToOriginal[i]] = i;
+}
+
+/**
+ * @brief Builds the relabeled graph: vertex i of the result is getOriginalId(i) of `graph`.
+ *
+ * Edges are inserted by increasing new id, so each vertex's neighbors are listed in increasing
+ * order and allocated close to those of the previous vertex. Parallel edges and self-loops are
+ * dropped. A directed graph keeps its arcs; the ordering itself ignores their direction. Vertex
+ * costs follow their vertices.
+ */
+
+Graph VertexOrdering::apply(const Graph& graph) const {
+    bool isDirected = graph.isDirectedGraph();
+    std::vector<std::vector<size_t>> adjacency = adjacencyOf(graph);
+    size_t order = adjacency.size();
+    Graph reordered(order, isDirected);
+
+    for (size_t i = 0; i < order; ++i) {
+        size_t original = this->newToOriginal[i];
+        std::vector<size_t> neighbors;
+        reordered.setCost(i, graph.getCost(original));
+
+        if (isDirected) {
+            for (const auto& neighbor: graph.getAdjacencyList(original))
+                if ((neighbor < order) && (neighbor != original))
+                    neighbors.push_back(this->originalToNew[neighbor]);
+        } else {
+            for (const auto& neighbor: adjacency[original])
+                if (this->originalToNew[neighbor] > i)
+                    neighbors.push_back(this->originalToNew[neighbor]);
+        }
+
+        std::sort(neighbors.begin(), neighbors.end());
+        for (const auto& neighbor: neighbors)
+            reordered.addEdge(i, neighbor);
+    }
+
+    return reordered;
+}
+
+/**
+ * @brief Maps a solution of the relabeled graph back to the original vertex ids.
+ */
+
+std::vector<int> VertexOrdering::toOriginal(const std::vector<int>& solution) const {
+    std::vector<int> original(solution.size());
+    for (size_t i = 0; i < solution.size(); ++i)
+        original[this->newToOriginal[i]] = solution[i];
+    return original;
+}
+
+/**
+ * @brief Maps a solution of the original graph to the relabeled ids, e.g. to warm-start a search.
+ */
+
+std::vector<int> VertexOrdering::toReordered(const std::vector<int>& solution) const {
+    std::vector<int> reordered(solution.size());
+    for (size_t i = 0; i < solution.size(); ++i)
+        reordered[this->originalToNew[i]] = solution[i];
+    return reordered;
+}
+
+size_t VertexOrdering::getNewId(size_t originalVertex) const { return this->originalToNew.at(originalVertex); }
+
+size_t VertexOrdering::getOriginalId(size_t newVertex) const { return this->newToOriginal.at(newVertex); }
+
+/**
+ * @brief Parses "none", "bfs", "rcm", "degree" or "community".
+ *
+ * @throws std::invalid_argument for any other name.
+ */
+
+OrderingStrategy VertexOrdering::parse(const std::string& name) {
+    if (name == "none")
+        return OrderingStrategy::Identity;
+    if (name == "bfs")
+        return OrderingStrategy::BFS;
+    if (name == "rcm")
+        return OrderingStrategy::ReverseCuthillMcKee;
+    if (name == "degree")
+        return OrderingStrategy::DegreeDescending;
+    if (name == "community")
+        return OrderingStrategy::Community;
+
+    throw std::invalid_argument("Unknown vertex ordering " + name);
+}
+
+/**
+ * @brief Mean distance |u - v| between the ids of adjacent vertices, a proxy for how far apart
+ * the entries of neighbors lie in per-vertex arrays.
+ */
+
+double VertexOrdering::averageNeighborDistance(const Graph& graph) {
+    double distance = 0.0;
+    size_t edges = 0;
+
+    for (size_t i = 0; i < graph.getOrder(); ++i) {
+        if (!graph.vertexExists(i))
+            continue;
+
+        for (const auto& neighbor: graph.getAdjacencyList(i)) {
+            distance += neighbor > i ? neighbor - i : i - neighbor;
+            ++edges;
+        }
+    }
+
+    return edges == 0 ? 0.0 : distance / edges;
+}
+
+std::vector<std::vector<size_t>> VertexOrdering::adjacencyOf(const Graph& graph) {
+    size_t order = graph.getOrder();
+    std::vector<std::vector<size_t>> adjacency(order);
+
+    for (size_t i = 0; i < order; ++i) {
+        if (!graph.vertexExists(i))
+            continue;
+
+        for (const auto& j: graph.getAdjacencyList(i)) {
+            if ((j == i) || (j >= order))
+                continue;
+            adjacency[i].push_back(j);
+            adjacency[j].push_back(i);
+        }
+    }
+
+    for (auto& neighbors: adjacency) {
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    }
+
+    return adjacency;
+}
+
+/**
+ * @brief Breadth-first order of all components.
+ *
+ * @param adjacency The deduplicated adjacency lists.
+ * @param byDegree Visit the neighbors of a vertex by increasing degree (Cuthill-McKee) instead of by id.
+ * @param peripheralStart Start each component from a pseudo-peripheral vertex, found by repeated
+ *        breadth-first searches from a vertex of minimum degree, instead of from its lowest vertex.
+ */
+
+std::vector<size_t> VertexOrdering::breadthFirstOrder(const std::vector<std::vector<size_t>>& adjacency,
+                                                      bool byDegree, bool peripheralStart) {
+    const size_t unvisited = std::numeric_limits<size_t>::max();
+    size_t order = adjacency.size();
+    std::vector<size_t> result;
+    std::vector<size_t> distance(order, unvisited);
+    std::vector<bool> placed(order, false);
+    std::vector<size_t> starts(order);
+
+    result.reserve(order);
+    for (size_t i = 0; i < order; ++i)
+        starts[i] = i;
+
+    auto byIncreasingDegree = [&adjacency](size_t a, size_t b) {
+        return adjacency[a].size() < adjacency[b].size();
+    };
+
+    if (peripheralStart)
+        std::stable_sort(starts.begin(), starts.end(), byIncreasingDegree);
+
+    // Breadth-first search of the component of `start`; returns the vertices in visiting order, its
+    // eccentricity and a vertex of minimum degree among the farthest ones.
+    auto search = [&](size_t start, size_t& farthest, size_t& eccentricity) {
+        std::vector<size_t> visited = { start };
+        distance[start] = 0;
+
+        for (size_t head = 0; head < visited.size(); ++head) {
+            size_t vertex = visited[head];
+            std::vector<size_t> neighbors = adjacency[vertex];
+
+            if (byDegree)
+                std::stable_sort(neighbors.begin(), neighbors.end(), byIncreasingDegree);
+
+            for (const auto& neighbor: neighbors)
+                if (distance[neighbor] == unvisited) {
+                    distance[neighbor] = distance[vertex] + 1;
+                    visited.push_back(neighbor);
+                }
+        }
+
+        eccentricity = distance[visited.back()];
+        farthest = visited.back();
+
+        for (const auto& vertex: visited) {
+            if ((distance[vertex] == eccentricity) && (adjacency[vertex].size() < adjacency[farthest].size()))
+                farthest = vertex;
+            distance[vertex] = unvisited;
+        }
+
+        return visited;
+    };
+
+    for (const auto& candidate: starts) {
+        if (placed[candidate])
+            continue;
+
+        size_t farthest = 0, eccentricity = 0;
+        std::vector<size_t> visited = search(candidate, farthest, eccentricity);
+
+        // George-Liu: restart from a farthest vertex while that increases the eccentricity.
+        for (size_t round = 0; peripheralStart && (round < 4); ++round) {
+            size_t nextFarthest = 0, nextEccentricity = 0;
+            std::vector<size_t> next = search(farthest, nextFarthest, nextEccentricity);
+
+            if (nextEccentricity <= eccentricity)
+                break;
+
+            visited = std::move(next);
+            farthest = nextFarthest;
+            eccentricity = nextEccentricity;
+        }
+
+        for (const auto& vertex: visited) {
+            placed[vertex] = true;
+            result.push_back(vertex);
+        }
+    }
+
+    return result;
+}
+
+std::vector<size_t> VertexOrdering::degreeOrder(const std::vector<std::vector<size_t>>& adjacency) {
+    std::vector<size_t> result(adjacency.size());
+    for (size_t i = 0; i < result.size(); ++i)
+        result[i] = i;
+
+    std::stable_sort(result.begin(), result.end(), [&adjacency](size_t a, size_t b) {
+        return adjacency[a].size() > adjacency[b].size();
+    });
+
+    return result;
+}
+
+/**
+ * @brief Community order: asynchronous label propagation (each vertex adopts the most frequent
+ * label among its neighbors, the smallest on ties, for at most 10 sweeps), then the communities
+ * are emitted whole, in the order a breadth-first traversal first reaches each of them.
+ */
+
+std::vector<size_t> VertexOrdering::communityOrder(const std::vector<std::vector<size_t>>& adjacency) {
+    size_t order = adjacency.size();
+    std::vector<size_t> community(order);
+    std::vector<size_t> frequency(order, 0);
+
+    for (size_t i = 0; i < order; ++i)
+        community[i] = i;
+
+    for (size_t sweep = 0; sweep < 10; ++sweep) {
+        bool changed = false;
+
+        for (size_t i = 0; i < order; ++i) {
+            if (adjacency[i].empty())
+                continue;
+
+            size_t best = community[i], bestFrequency = 0;
+            for (const auto& neighbor: adjacency[i]) {
+                size_t label = community[neighbor];
+                size_t count = ++frequency[label];
+                if ((count > bestFrequency) || ((count == bestFrequency) && (label < best))) {
+                    best = label;
+                    bestFrequency = count;
+                }
+            }
+
+            for (const auto& neighbor: adjacency[i])
+                frequency[community[neighbor]] = 0;
+
+            if (best != community[i]) {
+                community[i] = best;
+                changed = true;
+            }
+        }
+
+        if (!changed)
+            break;
+    }
+
+    std::vector<size_t> traversal = breadthFirstOrder(adjacency, false, false);
+    std::vector<std::vector<size_t>> members(order);
+    std::vector<size_t> communities;
+
+    for (const auto& vertex: traversal) {
+        if (members[community[vertex]].empty())
+            communities.push_back(community[vertex]);
+        members[community[vertex]].push_back(vertex);
+    }
+
+    std::vector<size_t> result;
+    result.reserve(order);
+    for (const auto& label: communities)
+        result.insert(result.end(), members[label].begin(), members[label].end());
+
+    return result;
+}
@@ -2,30 +2,271 @@
 #include "DoubleRomanDomination.hpp"
 #include "Graph.hpp"             
 #include "AntColonyOptimization.hpp"
+#include "BatchSolver.hpp"
+#include "VertexOrdering.hpp"
+#include "DynamicSolver.hpp"
+#include "TabuSearch.hpp"
+#include "ResultFile.hpp"
+#include "Configuration.hpp"
+#include "Random.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
 
+namespace {
 
-int main(int argc, char** argv) {
-    if (argc > 5) {
-        Graph graph("graph.txt", false);
-        // graph, populationSize, genesSize, generations, heuristic, numberOfAnts, iterations
+const char* usage =
+    "Usage:\n"
+    "  app <population_size> <generations> <heuristic> <number_of_ants> <iterations> [rvns_threads] [mode]\n"
+    "      [ordering] [edges] [operators] [aco_improvement]\n"
+    "  app run [--config FILE] [--key value]...\n"
+    "  app batch <directory|manifest> <output.csv> <population_size> <generations> <heuristic> <number_of_ants>\n"
+    "      <iterations> [seeds] [algorithms] [threads] [ordering] [edges] [operators]\n"
+    "  app batch [--config FILE] --input <directory|manifest> --output <output.csv> [--key value]...\n"
+    "  app dynamic <changes> <population_size> <generations> <heuristic> <number_of_ants> <iterations>\n"
+    "      [update_generations] [update_iterations] [edges] [operators]\n"
+    "  app tabu <iterations> [heuristic] [stall_iterations] [edges]\n"
+    "See README.md for the options and the format of graph.txt.\n";
+
+/**
+ * @brief Runs the mode named by the arguments.
+ *
+ * @return false if no mode matches them.
+ */
+
+bool runMode(int argc, char** argv) {
+    if ((argc > 1) && (std::string(argv[1]) == "run")) {
+        Configuration configuration(argc, argv, 2);
+        BatchSettings settings;
+        settings.input = "graph.txt";
+        settings.firstSeed = Random::seedFromEnvironment();
+        configuration.apply(settings);
+        configuration.checkUnused();
+        BatchSolver::checkSettings(settings);
+
+        Graph original(settings.input, settings.directed);
+        VertexOrdering ordering(original, settings.ordering);
+        Graph graph = settings.ordering != OrderingStrategy::Identity ? ordering.apply(original) : original;
+        size_t lowerBound = DominationBounds::lowerBound(graph);
+        size_t numberOfRVNSThreads = std::max<size_t>(1, settings.numberOfThreads);
+        ResultWriter writer(original, settings.input, settings.firstSeed, lowerBound);
+
+        for (const auto& algorithm: settings.algorithms) {
+            Random::seed(settings.firstSeed);
+            auto start = std::chrono::steady_clock::now();
+            std::vector<int> solution = ordering.toOriginal(
+                BatchSolver::solveGraph(settings, graph, algorithm, numberOfRVNSThreads));
+            double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            size_t weight = original.getWeight(solution);
+
+            std::cout << algorithm << ": " << weight << (weight == lowerBound ? " (optimal)" : "") << ", "
+                      << milliseconds << " ms" << std::endl;
+            if (!settings.output.empty())
+                writer.add(algorithm, solution, milliseconds);
+            else {
+                std::cout << std::endl;
+                ResultWriter::printLabels(solution);
+                std::cout << std::endl;
+            }
+        }
+
+        std::cout << "Lower bound: " << lowerBound << ", seed: " << settings.firstSeed << std::endl;
+        if (!settings.output.empty()) {
+            writer.write(settings.output);
+            std::cout << "Result written to " << settings.output << std::endl;
+        }
+    }
+
+    else if ((argc > 2) && (std::string(argv[1]) == "batch") && (std::string(argv[2]).compare(0, 2, "--") == 0)) {
+        BatchSettings settings;
+        if (const char* affinity = std::getenv("DRD_AFFINITY"))
+            settings.affinity = Topology::parse(affinity);
+        if (const char* replicate = std::getenv("DRD_REPLICATE_GRAPH"))
+            settings.replicateGraph = std::string(replicate) != "0";
+
+        Configuration configuration(argc, argv, 2);
+        configuration.apply(settings);
+        configuration.checkUnused();
+        if (settings.input.empty() || settings.output.empty())
+            throw std::invalid_argument("A batch needs --input and --output");
+
+        BatchSolver batch(settings);
+        size_t results = batch.run();
+        std::cout << results << " results written to " << settings.output;
+        if (batch.getNumberOfFailures() > 0)
+            std::cout << ", " << batch.getNumberOfFailures() << " graphs skipped";
+        if (batch.getNumberOfFailedTasks() > 0)
+            std::cout << ", " << batch.getNumberOfFailedTasks() << " tasks failed";
+        std::cout << std::endl;
+    }
+
+    else if ((argc > 8) && (std::string(argv[1]) == "batch")) {
+        BatchSettings settings;
+        settings.input = argv[2];
+        settings.output = argv[3];
+        settings.populationSize = std::stoi(argv[4]);
+        settings.generations = std::stoi(argv[5]);
+        settings.heuristic = std::stoi(argv[6]);
+        settings.numberOfAnts = std::stoi(argv[7]);
+        settings.iterations = std::stoi(argv[8]);
+        settings.seeds = argc > 9 ? std::stoi(argv[9]) : 1;
+        settings.numberOfThreads = argc > 11 ? std::stoi(argv[11]) : 0;
+        settings.ordering = argc > 12 ? VertexOrdering::parse(argv[12]) : OrderingStrategy::Identity;
+        settings.directed = (argc > 13) && (std::string(argv[13]) == "directed");
+        settings.operators = argc > 14 ? GeneticOperators::parse(argv[14]) : GeneticOperators();
+        if (const char* affinity = std::getenv("DRD_AFFINITY"))
+            settings.affinity = Topology::parse(affinity);
+        if (const char* replicate = std::getenv("DRD_REPLICATE_GRAPH"))
+            settings.replicateGraph = std::string(replicate) != "0";
+
+        if (argc > 10) {
+            std::stringstream algorithms(argv[10]);
+            std::string algorithm;
+            settings.algorithms.clear();
+            while (std::getline(algorithms, algorithm, ','))
+                settings.algorithms.push_back(algorithm);
+        }
+
+        BatchSolver batch(settings);
+        size_t results = batch.run();
+        std::cout << results << " results written to " << settings.output;
+        if (batch.getNumberOfFailures() > 0)
+            std::cout << ", " << batch.getNumberOfFailures() << " graphs skipped";
+        if (batch.getNumberOfFailedTasks() > 0)
+            std::cout << ", " << batch.getNumberOfFailedTasks() << " tasks failed";
+        std::cout << std::endl;
+    }
+
+    else if ((argc > 7) && (std::string(argv[1]) == "dynamic")) {
+        DynamicSettings settings;
+        settings.populationSize = std::stoi(argv[3]);
+        settings.generations = std::stoi(argv[4]);
+        settings.heuristic = std::stoi(argv[5]);
+        settings.numberOfAnts = std::stoi(argv[6]);
+        settings.iterations = std::stoi(argv[7]);
+        settings.updateGenerations = argc > 8 ? std::stoi(argv[8]) : settings.generations / 10;
+        settings.updateIterations = argc > 9 ? std::stoi(argv[9]) : settings.iterations / 10;
+        settings.operators = argc > 11 ? GeneticOperators::parse(argv[11]) : GeneticOperators();
+
+        std::vector<std::vector<EdgeDelta>> batches = DynamicSolver::readDeltas(argv[2]);
+        Graph graph("graph.txt", (argc > 10) && (std::string(argv[10]) == "directed"));
+        DynamicSolver solver(graph, settings);
+
+        std::cout << "Initial solution: " << solver.getWeight() << " ("
+                  << solver.getStatistics().searchMilliseconds << " ms)" << std::endl;
+
+        for (size_t i = 0; i < batches.size(); ++i) {
+            solver.update(batches[i]);
+            const UpdateStatistics& statistics = solver.getStatistics();
+            std::cout << "Batch " << i + 1 << ": +" << statistics.addedEdges << " -" << statistics.removedEdges
+                      << " edges, " << statistics.affectedVertices << " affected, " << statistics.repairedVertices
+                      << " repaired, weight " << statistics.repairedWeight << " after repair ("
+                      << statistics.repairMilliseconds << " ms), " << statistics.weight << " after search ("
+                      << statistics.searchMilliseconds << " ms)" << std::endl;
+        }
+
+        std::cout << "\nSolution: " << std::endl;
+        ResultWriter::printLabels(solver.getSolution());
+    }
+
+    else if ((argc > 2) && (std::string(argv[1]) == "tabu")) {
+        Graph graph("graph.txt", (argc > 5) && (std::string(argv[5]) == "directed"));
+        TabuSettings settings;
+        settings.iterations = std::stoi(argv[2]);
+        settings.stallIterations = argc > 4 ? std::stoi(argv[4]) : settings.stallIterations;
+        short int heuristic = argc > 3 ? std::stoi(argv[3]) : 1;
+        unsigned int seed = Random::seedFromEnvironment();
+        const char* resultPath = std::getenv("DRD_RESULT");
+        auto start = std::chrono::steady_clock::now();
+        Chromosome initial = heuristic == 2 ? DoubleRomanDomination::heuristic2(graph)
+                           : heuristic == 3 ? DoubleRomanDomination::heuristic3(graph)
+                           : DoubleRomanDomination::heuristic1(graph);
+
+        TabuSearch tabuSearch(graph, settings);
+        size_t lowerBound = DominationBounds::lowerBound(graph);
+        tabuSearch.setLowerBound(lowerBound);
+        size_t weight = tabuSearch.run(initial.genes);
+        double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        const TabuStatistics& statistics = tabuSearch.getStatistics();
+
+        std::cout << "Double Roman Domination Number computed by Tabu Search: " << weight << std::endl;
+        std::cout << "Lower bound: " << lowerBound << (weight == lowerBound ? " (optimal)" : "") << std::endl;
+        std::cout << statistics.iterations << " iterations, " << statistics.improvements << " improvements, "
+                  << statistics.aspirations << " aspirations, " << statistics.infeasibleIterations
+                  << " infeasible" << std::endl;
+
+        if (resultPath) {
+            ResultWriter writer(graph, "graph.txt", seed, lowerBound);
+            writer.add("tabu", tabuSearch.getBestSolution(), milliseconds);
+            writer.write(resultPath);
+            std::cout << "Result written to " << resultPath << std::endl;
+        }
+        else {
+            std::cout << "\nTabu Search solution: " << std::endl;
+            ResultWriter::printLabels(tabuSearch.getBestSolution());
+        }
+    }
+
+    else if (argc > 5) {
+        unsigned int seed = Random::seedFromEnvironment();
+        Graph original("graph.txt", (argc > 9) && (std::string(argv[9]) == "directed"));
+        VertexOrdering ordering(original, argc > 8 ? VertexOrdering::parse(argv[8]) : OrderingStrategy::Identity);
+        Graph graph = argc > 8 ? ordering.apply(original) : original;
+        ExecutionMode mode = (argc > 7) && (std::string(argv[7]) == "hybrid") ? ExecutionMode::Hybrid : ExecutionMode::Sequential;
+        GeneticOperators operators = argc > 10 ? GeneticOperators::parse(argv[10]) : GeneticOperators();
+        bool localSearchACO = (argc > 11) && (std::string(argv[11]) == "local-search");
+        const char* resultPath = std::getenv("DRD_RESULT");
+        // graph, populationSize, genesSize, generations, heuristic, numberOfAnts, iterations, RVNS threads, mode,
+        // checkpoint, GA operators, ACO daemon
         DoubleRomanDomination* drd = new DoubleRomanDomination(graph, std::stoi(argv[1]), graph.getOrder(), std::stoi(argv[2]),
                 std::stoi(argv[3]),
-                std::stoi(argv[4]), std::stoi(argv[5])); 
+                std::stoi(argv[4]), std::stoi(argv[5]), argc > 6 ? std::stoi(argv[6]) : 1, mode,
+                CheckpointSettings::fromEnvironment(), operators, localSearchACO); 
         std::cout << "Double Roman Domination Number computed by Genetic Algorithm: " << drd->getGamma2rGeneticAlgorithm() << std::endl;
         std::cout << "Double Roman Domination Number computed by ACO: " << drd->getGamma2rACO() << std::endl;
+        std::cout << "Lower bound: " << drd->getLowerBound()
+                  << (std::min(drd->getGamma2rGeneticAlgorithm(), drd->getGamma2rACO()) == drd->getLowerBound()
+                      ? " (optimal)" : "") << std::endl;
+        std::cout << "RVNS improvement rate: " << drd->getRVNSStatisticsACO().getImprovementRate()
+                  << ", time per RVNS iteration: " << drd->getRVNSStatisticsACO().getTimePerIteration() << " us" << std::endl;
 
-        std::cout << "\nGenetic Algorithm solution: " << std::endl;
-        for (const auto& it: drd->getSolutionGeneticAlgorithm())
-           std::cout << it << " ";
-        std::cout << std::endl;
+        if (resultPath) {
+            ResultWriter writer(original, "graph.txt", seed, drd->getLowerBound());
+            writer.add("ga", ordering.toOriginal(drd->getSolutionGeneticAlgorithm()), drd->getMillisecondsGeneticAlgorithm());
+            writer.add("aco", ordering.toOriginal(drd->getSolutionACO()), drd->getMillisecondsACO());
+            writer.write(resultPath);
+            std::cout << "Result written to " << resultPath << std::endl;
+        }
+        else {
+            std::cout << "\nGenetic Algorithm solution: " << std::endl;
+            ResultWriter::printLabels(ordering.toOriginal(drd->getSolutionGeneticAlgorithm()));
 
-        std::cout << "\nACO solution: " << std::endl;
-        for (const auto& it: drd->getSolutionACO())
-           std::cout << it << " ";
-        std::cout << std::endl;
+            std::cout << "\nACO solution: " << std::endl;
+            ResultWriter::printLabels(ordering.toOriginal(drd->getSolutionACO()));
+        }
 
         delete drd;
     }
 
-	return 0;
+    else
+        return false;
+
+    return true;
+}
+
+}
+
+int main(int argc, char** argv) {
+    try {
+        if (runMode(argc, argv))
+            return 0;
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << "\n\n" << usage;
+        return 1;
+    }
+
+    std::cerr << usage;
+    return 1;
 }
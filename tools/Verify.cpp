@@ -0,0 +1,141 @@
+#include "Graph.hpp"
+#include "DominationBounds.hpp"
+#include "ResultFile.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Checks a result file against its graph.
+ *
+ * For every engine of the result, the labeling must give each vertex a label from 0 to 3, weigh
+ * the γ2R it claims, and come with a certificate that names, for each vertex labeled 0 or 1 and
+ * for no other, dominators that are in-neighbors of it in the graph: one labeled 3 or two labeled
+ * 2 or 3 for a 0, one labeled 2 or 3 for a 1. The check walks the labels once and tests each
+ * witness with one edge lookup, so it does not depend on the solver's domination code. A verified
+ * engine is reported optimal when its γ2R meets the lower bound recomputed from the graph; the
+ * bound recorded in the result is not trusted.
+ *
+ * Usage: verify <result.json|result.bin> [graph]
+ *
+ * The graph defaults to the path recorded in the result, read with the recorded edge direction.
+ * Exits with 0 when every engine is verified, 1 when one is not and 2 when the files cannot be
+ * read.
+ */
+
+namespace {
+
+const size_t maxReported = 10;
+
+std::vector<std::string> verify(const Graph& graph, const EngineResult& entry) {
+    std::vector<std::string> errors;
+    auto report = [&errors](const std::string& error) {
+        if (errors.size() < maxReported)
+            errors.push_back(error);
+    };
+
+    if (entry.labels.size() != graph.getOrder()) {
+        report("labels " + std::to_string(entry.labels.size()) + " vertices instead of " + std::to_string(graph.getOrder()));
+        return errors;
+    }
+
+    size_t weight = 0, next = 0;
+
+    for (size_t v = 0; v < entry.labels.size(); ++v) {
+        int label = entry.labels[v];
+        if ((label < 0) || (label > 3)) {
+            report("vertex " + std::to_string(v) + " has label " + std::to_string(label));
+            continue;
+        }
+
+        weight += label * graph.getCost(v);
+        if (label >= 2)
+            continue;
+
+        while ((next < entry.certificate.size()) && (entry.certificate[next][0] < v)) {
+            report("certificate entry for vertex " + std::to_string(entry.certificate[next][0]) + ", which is not labeled 0 or 1");
+            ++next;
+        }
+        if ((next == entry.certificate.size()) || (entry.certificate[next][0] != v)) {
+            report("no certificate entry for vertex " + std::to_string(v) + " labeled " + std::to_string(label));
+            continue;
+        }
+
+        const auto& witnessed = entry.certificate[next++];
+        size_t labeled3 = 0, labeled2 = 0;
+
+        for (size_t k = 1; k < 3; ++k) {
+            size_t witness = witnessed[k];
+            if (witness == EngineResult::none)
+                continue;
+
+            if ((witness >= graph.getOrder()) || !graph.edgeExists(witness, v))
+                report("witness " + std::to_string(witness) + " of vertex " + std::to_string(v) + " is not an in-neighbor of it");
+            else if ((k == 2) && (witness == witnessed[1]))
+                report("vertex " + std::to_string(v) + " names witness " + std::to_string(witness) + " twice");
+            else if (entry.labels[witness] == 3)
+                ++labeled3;
+            else if (entry.labels[witness] == 2)
+                ++labeled2;
+        }
+
+        bool dominated = label == 1 ? labeled3 + labeled2 >= 1 : (labeled3 >= 1) || (labeled3 + labeled2 >= 2);
+        if (!dominated)
+            report("the witnesses of vertex " + std::to_string(v) + " labeled " + std::to_string(label) + " do not dominate it");
+    }
+
+    for (; next < entry.certificate.size(); ++next)
+        report("certificate entry for vertex " + std::to_string(entry.certificate[next][0]) + ", which is not labeled 0 or 1");
+
+    if (weight != entry.gamma2r)
+        report("the labels weigh " + std::to_string(weight) + ", not the claimed " + std::to_string(entry.gamma2r));
+
+    return errors;
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: verify <result> [graph]" << std::endl;
+        return 2;
+    }
+
+    ResultFile result;
+    Graph graph;
+
+    try {
+        result = ResultReader::read(argv[1]);
+        graph = Graph(argc > 2 ? argv[2] : result.graphPath, result.directed);
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << std::endl;
+        return 2;
+    }
+
+    if ((graph.getOrder() != result.order) || (graph.getSize() != result.size)) {
+        std::cerr << "The result was computed on a graph of order " << result.order << " and size " << result.size
+                  << ", not on this one (" << graph.getOrder() << ", " << graph.getSize() << ")" << std::endl;
+        return 1;
+    }
+
+    bool verified = true;
+    size_t lowerBound = DominationBounds::lowerBound(graph);
+
+    for (const auto& entry: result.engines) {
+        std::vector<std::string> errors = verify(graph, entry);
+        verified = verified && errors.empty();
+
+        std::cout << entry.engine << ": gamma2r " << entry.gamma2r;
+        if (errors.empty()) {
+            std::cout << " verified" << (entry.gamma2r == lowerBound ? " (optimal)" : "") << ", "
+                      << entry.certificate.size() << " certificate entries, " << entry.milliseconds << " ms" << std::endl;
+            continue;
+        }
+
+        std::cout << " NOT verified" << std::endl;
+        for (const auto& error: errors)
+            std::cout << "  " << error << std::endl;
+    }
+
+    return verified ? 0 : 1;
+}